@@ -0,0 +1,133 @@
+#include "asset_bundle.h"
+#include "sprite_atlas.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+AssetBundle::~AssetBundle()
+{
+    close();
+}
+
+bool AssetBundle::open(const string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE fileMapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file); //The mapping keeps the file open
+    if (!fileMapping) return false;
+
+    void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(fileMapping);
+        return false;
+    }
+    data = static_cast<const Uint8*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    mapping = fileMapping;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd); //The mapping keeps the file open
+    if (view == MAP_FAILED) return false;
+
+    data = static_cast<const Uint8*>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    //Validate everything up front so lookups can trust the offsets
+    const BundleHeader* header = reinterpret_cast<const BundleHeader*>(data);
+    bool valid = size >= sizeof(BundleHeader)
+        && SDL_memcmp(header->magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) == 0
+        && header->version == BUNDLE_VERSION
+        && header->entryCount <= (size - sizeof(BundleHeader)) / sizeof(BundleEntry);
+
+    if (valid) {
+        const BundleEntry* list = reinterpret_cast<const BundleEntry*>(data + sizeof(BundleHeader));
+        for (Uint32 i = 0; i < header->entryCount && valid; i++) {
+            const BundleEntry& entry = list[i];
+            Uint64 pixelBytes = static_cast<Uint64>(entry.pitch) * entry.height;
+            valid = static_cast<Uint64>(entry.pathOffset) + entry.pathLength <= size
+                && entry.dataOffset <= size && pixelBytes <= size - entry.dataOffset;
+            if (valid) {
+                string entryPath(reinterpret_cast<const char*>(data + entry.pathOffset), entry.pathLength);
+                entries[SpriteAtlas::normalizePath(entryPath)] = &entry;
+            }
+        }
+    }
+
+    if (!valid) {
+        cout << "Asset bundle " << path << " is corrupt or from another version, ignoring it" << endl;
+        close();
+        return false;
+    }
+
+    cout << "Mapped asset bundle " << path << " (" << entries.size() << " images, "
+         << size / (1024 * 1024) << " MB)" << endl;
+    return true;
+}
+
+void AssetBundle::close()
+{
+    entries.clear();
+    if (!data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mapping));
+#else
+    munmap(const_cast<Uint8*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    mapping = nullptr;
+}
+
+bool AssetBundle::contains(const string& path) const
+{
+    return entries.find(SpriteAtlas::normalizePath(path)) != entries.end();
+}
+
+SDL_Texture* AssetBundle::createTexture(SDL_Renderer* renderer, const string& path) const
+{
+    auto it = entries.find(SpriteAtlas::normalizePath(path));
+    if (it == entries.end()) return nullptr;
+
+    const BundleEntry& entry = *it->second;
+    SDL_PixelFormat format = static_cast<SDL_PixelFormat>(entry.format);
+    SDL_Texture* texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC, entry.width, entry.height);
+    if (!texture) {
+        cout << "Error creating texture for " << path << ": " << SDL_GetError() << endl;
+        return nullptr;
+    }
+
+    //No decode and no conversion, the mapped pixels go straight to the renderer
+    SDL_UpdateTexture(texture, nullptr, data + entry.dataOffset, entry.pitch);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    return texture;
+}
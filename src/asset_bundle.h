@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// On-disk layout of the cooked asset bundle written by tools/asset_cooker.cpp.
+// The file starts with a BundleHeader, followed by entryCount BundleEntry records,
+// the path strings, and finally the pixel blocks, each aligned to BUNDLE_ALIGNMENT.
+// Pixels are premultiplied and already in the format the renderer uploads, so
+// images that are byte-for-byte identical are stored once and shared by their entries.
+const char BUNDLE_MAGIC[8] = { 'C', 'M', 'B', 'U', 'N', 'D', 'L', 'E' };
+const Uint32 BUNDLE_VERSION = 1;
+const Uint64 BUNDLE_ALIGNMENT = 4096;
+
+struct BundleHeader {
+    char magic[8];
+    Uint32 version;
+    Uint32 entryCount;
+};
+
+struct BundleEntry {
+    Uint32 pathOffset;  // from the start of the file
+    Uint32 pathLength;
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 format;      // SDL_PixelFormat
+    Uint64 dataOffset;  // from the start of the file
+    Uint64 contentHash;
+};
+
+// Read-only view of a cooked bundle. The file is memory mapped, so the pixels are
+// paged in on demand and shared with every other process that maps the same bundle.
+class AssetBundle {
+public:
+    AssetBundle() = default;
+    ~AssetBundle();
+    AssetBundle(const AssetBundle&) = delete;
+    AssetBundle& operator=(const AssetBundle&) = delete;
+
+    bool open(const string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    bool contains(const string& path) const;
+    // Uploads the image straight from the mapped pages, nullptr if it isn't in the bundle
+    SDL_Texture* createTexture(SDL_Renderer* renderer, const string& path) const;
+
+private:
+    const Uint8* data = nullptr;
+    size_t size = 0;
+    void* mapping = nullptr; // platform handle kept for unmapping
+    unordered_map<string, const BundleEntry*> entries; // keyed by normalized path
+};
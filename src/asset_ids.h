@@ -0,0 +1,218 @@
+// Generated by tools/asset_ids.cpp from src/res/sprites, do not edit.
+// Rerun tools/gen_asset_ids.sh after adding, renaming or removing sprites.
+#pragma once
+
+namespace Sprites {
+    struct CuttingGame {
+        enum Id {
+            BG,
+            DOTTED,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/cutting_game/bg.PNG",
+            "src/res/sprites/cutting_game/dotted.png",
+        };
+    };
+
+    struct EggGame {
+        enum Id {
+            BG_KITCHEN,
+            BOWL,
+            EGG_RESULT_0,
+            EGG_RESULT_1,
+            EGG_RESULT_2,
+            EGG_RESULT_3,
+            HAND_CRACK,
+            HAND_IDLE,
+            YOLK,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/egg_game/bg_kitchen.png",
+            "src/res/sprites/egg_game/bowl.png",
+            "src/res/sprites/egg_game/egg_result_0.png",
+            "src/res/sprites/egg_game/egg_result_1.png",
+            "src/res/sprites/egg_game/egg_result_2.png",
+            "src/res/sprites/egg_game/egg_result_3.png",
+            "src/res/sprites/egg_game/hand_crack.png",
+            "src/res/sprites/egg_game/hand_idle.png",
+            "src/res/sprites/egg_game/yolk.png",
+        };
+    };
+
+    struct FryingGame {
+        enum Id {
+            BACKGROUND_FRYING,
+            DIAL,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/frying_game/background_frying.png",
+            "src/res/sprites/frying_game/dial.png",
+        };
+    };
+
+    struct Ingredients {
+        enum Id {
+            CARROT,
+            EGG_ALMOST_COOKED,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/ingredients/carrot.png",
+            "src/res/sprites/ingredients/egg_almost_cooked.PNG",
+        };
+    };
+
+    struct MenuGraph {
+        enum Id {
+            COOKING_I,
+            CRACKING_I,
+            CUTTING_I,
+            ENDLESS_I,
+            EXIT,
+            HAND_L,
+            HAND_R,
+            MENU_BG,
+            MIXING_I,
+            MULTIPLE_I,
+            SELECT,
+            SETTING_BTN,
+            START_BTN,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/menu_graph/cooking_i.PNG",
+            "src/res/sprites/menu_graph/cracking_i.PNG",
+            "src/res/sprites/menu_graph/cutting_i.PNG",
+            "src/res/sprites/menu_graph/endless_i.PNG",
+            "src/res/sprites/menu_graph/exit.PNG",
+            "src/res/sprites/menu_graph/hand_l.PNG",
+            "src/res/sprites/menu_graph/hand_r.PNG",
+            "src/res/sprites/menu_graph/menu_bg.PNG",
+            "src/res/sprites/menu_graph/mixing_i.PNG",
+            "src/res/sprites/menu_graph/multiple_i.PNG",
+            "src/res/sprites/menu_graph/select.PNG",
+            "src/res/sprites/menu_graph/setting_btn.PNG",
+            "src/res/sprites/menu_graph/start_btn.PNG",
+        };
+    };
+
+    struct MixingGame {
+        enum Id {
+            BACKGROUND_MIXING,
+            BOWL,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/mixing_game/background_mixing.png",
+            "src/res/sprites/mixing_game/bowl.png",
+        };
+    };
+
+    struct Shared {
+        enum Id {
+            NO_TEXTURE,
+            COUNT
+        };
+        static constexpr const char* PATHS[COUNT] = {
+            "src/res/sprites/no_texture.png",
+        };
+    };
+}
+
+//Paths are relative to this header
+#if !__has_include("res/sprites/cutting_game/bg.PNG")
+#error "src/res/sprites/cutting_game/bg.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/cutting_game/dotted.png")
+#error "src/res/sprites/cutting_game/dotted.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/bg_kitchen.png")
+#error "src/res/sprites/egg_game/bg_kitchen.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/bowl.png")
+#error "src/res/sprites/egg_game/bowl.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/egg_result_0.png")
+#error "src/res/sprites/egg_game/egg_result_0.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/egg_result_1.png")
+#error "src/res/sprites/egg_game/egg_result_1.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/egg_result_2.png")
+#error "src/res/sprites/egg_game/egg_result_2.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/egg_result_3.png")
+#error "src/res/sprites/egg_game/egg_result_3.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/hand_crack.png")
+#error "src/res/sprites/egg_game/hand_crack.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/hand_idle.png")
+#error "src/res/sprites/egg_game/hand_idle.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/egg_game/yolk.png")
+#error "src/res/sprites/egg_game/yolk.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/frying_game/background_frying.png")
+#error "src/res/sprites/frying_game/background_frying.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/frying_game/dial.png")
+#error "src/res/sprites/frying_game/dial.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/ingredients/carrot.png")
+#error "src/res/sprites/ingredients/carrot.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/ingredients/egg_almost_cooked.PNG")
+#error "src/res/sprites/ingredients/egg_almost_cooked.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/cooking_i.PNG")
+#error "src/res/sprites/menu_graph/cooking_i.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/cracking_i.PNG")
+#error "src/res/sprites/menu_graph/cracking_i.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/cutting_i.PNG")
+#error "src/res/sprites/menu_graph/cutting_i.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/endless_i.PNG")
+#error "src/res/sprites/menu_graph/endless_i.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/exit.PNG")
+#error "src/res/sprites/menu_graph/exit.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/hand_l.PNG")
+#error "src/res/sprites/menu_graph/hand_l.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/hand_r.PNG")
+#error "src/res/sprites/menu_graph/hand_r.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/menu_bg.PNG")
+#error "src/res/sprites/menu_graph/menu_bg.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/mixing_i.PNG")
+#error "src/res/sprites/menu_graph/mixing_i.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/multiple_i.PNG")
+#error "src/res/sprites/menu_graph/multiple_i.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/select.PNG")
+#error "src/res/sprites/menu_graph/select.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/setting_btn.PNG")
+#error "src/res/sprites/menu_graph/setting_btn.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/menu_graph/start_btn.PNG")
+#error "src/res/sprites/menu_graph/start_btn.PNG is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/mixing_game/background_mixing.png")
+#error "src/res/sprites/mixing_game/background_mixing.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/mixing_game/bowl.png")
+#error "src/res/sprites/mixing_game/bowl.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
+#if !__has_include("res/sprites/no_texture.png")
+#error "src/res/sprites/no_texture.png is missing, restore it or rerun tools/gen_asset_ids.sh"
+#endif
@@ -0,0 +1,170 @@
+#include "asset_loader.h"
+#include "png_decoder.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+AssetLoader::AssetLoader(SDL_Renderer* renderer, JobSystem* jobSystem)
+    : renderer(renderer), jobSystem(jobSystem)
+{
+    queue = SDL_CreateAsyncIOQueue();
+    mutex = SDL_CreateMutex();
+    if (!queue || !mutex) {
+        cout << "Error creating asset loader: " << SDL_GetError() << endl;
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    //Reads that were still in flight have to finish before their buffers can be freed
+    if (queue) {
+        SDL_AsyncIOOutcome outcome;
+        while (reading > 0 && SDL_WaitAsyncIOResult(queue, &outcome, -1)) {
+            SDL_free(outcome.buffer);
+            reading--;
+        }
+        SDL_DestroyAsyncIOQueue(queue);
+    }
+
+    //Decodes already started still write into their jobs
+    for (auto& pair : jobs) {
+        jobSystem->wait(&pair.second->decoding);
+    }
+
+    //Anything not uploaded yet is dropped without calling back
+    for (auto& pair : jobs) {
+        if (pair.second->surface) {
+            SDL_DestroySurface(pair.second->surface);
+        }
+        delete pair.second;
+    }
+    jobs.clear();
+    ready.clear();
+
+    if (mutex) SDL_DestroyMutex(mutex);
+}
+
+uint64_t AssetLoader::loadTexture(const string& path, TextureCallback onReady)
+{
+    if (!queue || !mutex) return 0;
+
+    Job* job = new Job();
+    job->id = nextId++;
+    job->path = path;
+    job->onReady = move(onReady);
+
+    reading++;
+    if (!SDL_LoadFileAsync(path.c_str(), queue, job)) {
+        cout << "Error reading " << path << ": " << SDL_GetError() << endl;
+        reading--;
+        delete job;
+        return 0;
+    }
+
+    jobs[job->id] = job;
+    return job->id;
+}
+
+//The read is done, decoding it is up to the job system
+void AssetLoader::startDecode(const SDL_AsyncIOOutcome& outcome)
+{
+    Job* job = static_cast<Job*>(outcome.userdata);
+    job->reading = false;
+    reading--;
+    jobSystem->run("decode image", [this, outcome]() { decode(outcome); }, &job->decoding);
+}
+
+//Runs on a job worker
+void AssetLoader::decode(const SDL_AsyncIOOutcome& outcome)
+{
+    Job* job = static_cast<Job*>(outcome.userdata);
+
+    if (outcome.result == SDL_ASYNCIO_COMPLETE) {
+        job->surface = loadImage(outcome.buffer, outcome.bytes_transferred);
+        if (!job->surface) {
+            cout << "Error decoding " << job->path << ": " << SDL_GetError() << endl;
+        }
+    }
+    else {
+        cout << "Error reading " << job->path << ": " << SDL_GetError() << endl;
+    }
+    SDL_free(outcome.buffer);
+
+    SDL_LockMutex(mutex);
+    ready.push_back(job);
+    SDL_UnlockMutex(mutex);
+}
+
+void AssetLoader::upload(Job* job)
+{
+    SDL_Texture* texture = nullptr;
+    if (job->surface) {
+        texture = SDL_CreateTextureFromSurface(renderer, job->surface);
+        if (!texture) {
+            cout << "Error uploading " << job->path << ": " << SDL_GetError() << endl;
+        }
+        SDL_DestroySurface(job->surface);
+        job->surface = nullptr;
+    }
+
+    jobs.erase(job->id);
+    TextureCallback onReady = move(job->onReady);
+    delete job;
+
+    if (onReady) {
+        onReady(texture);
+    }
+    else if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void AssetLoader::pump(Uint64 budgetNS)
+{
+    SDL_AsyncIOOutcome outcome;
+    while (reading > 0 && SDL_GetAsyncIOResult(queue, &outcome)) {
+        startDecode(outcome);
+    }
+
+    Uint64 start = SDL_GetTicksNS();
+    //Always upload at least one image so loading can't stall on a slow frame
+    do {
+        //A decode queues its job just before its counter counts down, leave it until it has
+        SDL_LockMutex(mutex);
+        Job* job = nullptr;
+        auto it = find_if(ready.begin(), ready.end(), [](Job* queued) { return queued->decoding.isDone(); });
+        if (it != ready.end()) {
+            job = *it;
+            ready.erase(it);
+        }
+        SDL_UnlockMutex(mutex);
+        if (!job) break;
+
+        upload(job);
+    } while (SDL_GetTicksNS() - start < budgetNS);
+}
+
+void AssetLoader::finish(uint64_t id)
+{
+    auto found = jobs.find(id);
+    if (found == jobs.end()) return;
+    Job* job = found->second;
+
+    //Reads finish in any order, start decoding each one until ours is among them
+    SDL_AsyncIOOutcome outcome;
+    while (job->reading && SDL_WaitAsyncIOResult(queue, &outcome, -1)) {
+        startDecode(outcome);
+    }
+    if (job->reading) return; //The queue failed, pump() picks it up if it ever arrives
+    jobSystem->wait(&job->decoding); //Helps with other jobs rather than just sitting there
+
+    SDL_LockMutex(mutex);
+    auto it = find(ready.begin(), ready.end(), job);
+    if (it != ready.end()) {
+        ready.erase(it);
+    }
+    SDL_UnlockMutex(mutex);
+
+    upload(job);
+}
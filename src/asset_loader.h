@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include "job_system.h"
+
+using namespace std;
+
+// Loads textures without blocking the game loop.
+// Files are read with SDL's async I/O, PNGs are decoded to surfaces by jobs on the
+// JobSystem and only the upload to the GPU happens on the main thread, inside pump(),
+// which stops once its time budget for the frame is used up.
+class AssetLoader {
+public:
+    // Called on the main thread with the uploaded texture, or nullptr if loading failed.
+    // The callback takes ownership of the texture.
+    using TextureCallback = function<void(SDL_Texture*)>;
+
+    // jobSystem runs the decodes and has to outlive the loader
+    AssetLoader(SDL_Renderer* renderer, JobSystem* jobSystem);
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Starts loading a texture and returns an id for finish(), or 0 if the read could not be queued
+    uint64_t loadTexture(const string& path, TextureCallback onReady);
+
+    // Starts decoding the files that have been read, then uploads decoded images until
+    // budgetNS has passed. Call once per frame.
+    void pump(Uint64 budgetNS);
+
+    // Blocks until the given load is decoded and uploads it right away
+    void finish(uint64_t id);
+
+    size_t getPendingCount() const { return jobs.size(); }
+
+private:
+    struct Job {
+        uint64_t id = 0;
+        string path;
+        TextureCallback onReady;
+        SDL_Surface* surface = nullptr;
+        bool reading = true; // main thread only
+        JobCounter decoding; // its decode, the job is only freed once this is done
+    };
+
+    void startDecode(const SDL_AsyncIOOutcome& outcome);
+    void decode(const SDL_AsyncIOOutcome& outcome);
+    void upload(Job* job);
+
+    SDL_Renderer* renderer;
+    JobSystem* jobSystem;
+    SDL_AsyncIOQueue* queue = nullptr;
+
+    SDL_Mutex* mutex = nullptr;
+    deque<Job*> ready; // decoded and waiting for upload, guarded by mutex
+
+    unordered_map<uint64_t, Job*> jobs; // every load still in flight, main thread only
+    uint64_t nextId = 1;
+    int reading = 0; // main thread only
+};
@@ -1,4 +1,5 @@
 #include "button.h"
+#include "text_renderer.h"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <iostream>
@@ -70,28 +71,9 @@ void Button::render(SDLState& state) {
     SDL_RenderRect(renderer, &rect);
 
     // Render text
-    if (!text.empty() && state.font) {
+    if (!text.empty() && state.font && state.text) {
         SDL_Color textColor = { 255, 255, 255, SDL_ALPHA_OPAQUE };
-        SDL_Surface* textSurface = TTF_RenderText_Solid(state.font, text.c_str(), 0, textColor);
-
-        if (textSurface) {
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-            if (textTexture) {
-                float textW, textH;
-                SDL_GetTextureSize(textTexture, &textW, &textH);
-
-                SDL_FRect textRect = {
-                    x + (w - textW) / 2,
-                    y + (h - textH) / 2,
-                    textW,
-                    textH
-                };
-
-                SDL_RenderTexture(renderer, textTexture, nullptr, &textRect);
-                SDL_DestroyTexture(textTexture);
-            }
-            SDL_DestroySurface(textSurface);
-        }
+        label.setText(state.text, state.font, text.c_str(), textColor);
+        label.render(x + w / 2, y + h / 2, 0.5f, 0.5f);
     }
-}
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <string>
 #include <functional>
 #include "data_structs.h"
+#include "text_label.h"
 
 class Button {
 public:
@@ -19,6 +20,7 @@ public:
 private:
     float x, y, w, h;
     string text;
+    TextLabel label; //Laid out once, the text never changes
     bool isHovered;
     bool isPressed;
     ClickCallback onClick; //What function should be called when clicked
@@ -0,0 +1,46 @@
+#include "clock.h"
+
+//Game time starts at the real time so values read before the first sample look like SDL_GetTicks()
+Clock::Clock() : lastRealNS(SDL_GetTicksNS()), gameNS(lastRealNS)
+{
+}
+
+void Clock::sample()
+{
+    Uint64 now = SDL_GetTicksNS();
+    Uint64 elapsed = now - lastRealNS;
+    lastRealNS = now;
+    if (paused) return;
+
+    if (scale == 1.0) {
+        gameNS += elapsed;
+    }
+    else {
+        double scaled = elapsed * scale + remainderNS;
+        Uint64 whole = static_cast<Uint64>(scaled);
+        remainderNS = scaled - whole;
+        gameNS += whole;
+    }
+}
+
+Uint64 Clock::gameTimeAt(Uint64 realNS) const
+{
+    if (paused) return gameNS;
+    double offset = (static_cast<double>(realNS) - static_cast<double>(lastRealNS)) * scale;
+    if (offset < 0.0 && -offset >= static_cast<double>(gameNS)) return 0;
+    return static_cast<Uint64>(static_cast<Sint64>(gameNS) + static_cast<Sint64>(offset));
+}
+
+void Clock::setPaused(bool paused)
+{
+    if (paused == this->paused) return;
+    sample(); //Count the time up to now at the old state
+    this->paused = paused;
+}
+
+void Clock::setScale(double scale)
+{
+    sample();
+    this->scale = SDL_max(scale, 0.0);
+    remainderNS = 0.0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+using namespace std;
+
+// The game's time source. The loop samples SDL_GetTicksNS() once per frame and once per
+// tick, and everything else reads that sample, so all code running in the same frame or
+// tick sees the same time and reading it is just a load.
+// Game time stops while paused and runs at the given scale; real time always runs.
+class Clock {
+public:
+    Clock();
+
+    // Reads the system clock and advances game time by the time since the last sample
+    void sample();
+
+    // Game time at the last sample
+    Uint64 nowNS() const { return gameNS; }
+    Uint64 nowMS() const { return gameNS / SDL_NS_PER_MS; }
+    // Unscaled time at the last sample, for scheduling the loop itself
+    Uint64 realNS() const { return lastRealNS; }
+    // Game time at an instant on the SDL_GetTicksNS() timeline, such as an event's
+    // timestamp, worked out from the last sample. Lets input be judged when it happened
+    // rather than when it is handled.
+    Uint64 gameTimeAt(Uint64 realNS) const;
+
+    void setPaused(bool paused);
+    bool isPaused() const { return paused; }
+    // 1 is real time, 0.5 half speed. Negative scales are treated as 0.
+    void setScale(double scale);
+    double getScale() const { return scale; }
+
+private:
+    Uint64 lastRealNS;
+    Uint64 gameNS;
+    double scale = 1.0;
+    double remainderNS = 0.0; // fractions of a nanosecond lost to scaling, carried to the next sample
+    bool paused = false;
+};
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cmath>
+#include "cursor.h"
+
+void getLatestMousePosition(SDL_Renderer* renderer, float* x, float* y)
+{
+    float windowX, windowY;
+    SDL_GetMouseState(&windowX, &windowY);
+
+    float renderX = windowX, renderY = windowY;
+    SDL_RenderCoordinatesFromWindow(renderer, windowX, windowY, &renderX, &renderY);
+    if (x) *x = renderX;
+    if (y) *y = renderY;
+}
+
+SolidCursor::~SolidCursor()
+{
+    reset();
+}
+
+bool SolidCursor::show(SDL_Window* window, SDL_Renderer* renderer, float w, float h, SDL_Color color)
+{
+    reset();
+
+    //The logical size in window coordinates, then in pixels on high density displays
+    float left, top, right, bottom;
+    SDL_RenderCoordinatesToWindow(renderer, 0.0f, 0.0f, &left, &top);
+    SDL_RenderCoordinatesToWindow(renderer, w, h, &right, &bottom);
+    float density = SDL_GetWindowPixelDensity(window);
+    if (density <= 0.0f) density = 1.0f;
+    int pixelW = SDL_max(1, static_cast<int>(lroundf((right - left) * density)));
+    int pixelH = SDL_max(1, static_cast<int>(lroundf((bottom - top) * density)));
+
+    SDL_Surface* image = SDL_CreateSurface(pixelW, pixelH, SDL_PIXELFORMAT_RGBA32);
+    if (!image) {
+        cout << "Error creating cursor image: " << SDL_GetError() << endl;
+        return false;
+    }
+    SDL_FillSurfaceRect(image, nullptr, SDL_MapSurfaceRGBA(image, color.r, color.g, color.b, color.a));
+    cursor = SDL_CreateColorCursor(image, pixelW / 2, pixelH / 2);
+    SDL_DestroySurface(image);
+    if (!cursor) {
+        cout << "Error creating cursor: " << SDL_GetError() << endl;
+        return false;
+    }
+
+    SDL_SetCursor(cursor);
+    SDL_ShowCursor();
+    return true;
+}
+
+void SolidCursor::reset()
+{
+    if (!cursor) return;
+    SDL_SetCursor(SDL_GetDefaultCursor());
+    SDL_DestroyCursor(cursor);
+    cursor = nullptr;
+}
+
+void confineMouse(SDL_Window* window, SDL_Renderer* renderer, const SDL_FRect* rect)
+{
+    if (!rect) {
+        SDL_SetWindowMouseRect(window, nullptr);
+        return;
+    }
+
+    float left, top, right, bottom;
+    SDL_RenderCoordinatesToWindow(renderer, rect->x, rect->y, &left, &top);
+    SDL_RenderCoordinatesToWindow(renderer, rect->x + rect->w, rect->y + rect->h, &right, &bottom);
+    SDL_Rect area = {
+        static_cast<int>(ceilf(left)), static_cast<int>(ceilf(top)),
+        SDL_max(1, static_cast<int>(floorf(right) - ceilf(left))),
+        SDL_max(1, static_cast<int>(floorf(bottom) - ceilf(top)))
+    };
+    if (!SDL_SetWindowMouseRect(window, &area)) {
+        cout << "Error confining mouse: " << SDL_GetError() << endl;
+    }
+}
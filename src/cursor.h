@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+using namespace std;
+
+// The mouse position in render coordinates as of the main loop's last event pump, not as
+// of the last motion event the simulation thread handled. Doesn't pump events itself, the
+// main loop owns them. Call it right where something that follows the mouse is drawn, and
+// only for looks: anything that is scored should use the position from its events.
+void getLatestMousePosition(SDL_Renderer* renderer, float* x, float* y);
+
+// A solid colored hardware cursor. The OS draws and moves it at its own rate, so it
+// keeps up with the mouse however long our frames take.
+// Sized from a rect in render coordinates, so it matches what would have been drawn.
+class SolidCursor {
+public:
+    SolidCursor() = default;
+    ~SolidCursor();
+    SolidCursor(const SolidCursor&) = delete;
+    SolidCursor& operator=(const SolidCursor&) = delete;
+
+    // Makes it the current cursor, with the hot spot in the middle. Returns false when the
+    // platform has no color cursors, draw it yourself then.
+    bool show(SDL_Window* window, SDL_Renderer* renderer, float w, float h, SDL_Color color);
+    // Goes back to the system cursor
+    void reset();
+
+    explicit operator bool() const { return cursor != nullptr; }
+
+private:
+    SDL_Cursor* cursor = nullptr;
+};
+
+// Keeps the mouse inside rect, given in render coordinates, or lets it go when rect is nullptr
+void confineMouse(SDL_Window* window, SDL_Renderer* renderer, const SDL_FRect* rect);
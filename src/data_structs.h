@@ -8,6 +8,18 @@
 
 using namespace std;
 
+class TextRenderer;
+class FontManager;
+class StringTable;
+class TextureCache;
+class AssetLoader;
+class Clock;
+class FramePacer;
+class DisplaySettings;
+class PowerPolicy;
+class Simulation;
+class JobSystem;
+
 enum class GameState {
 	MAIN_MENU,
 	LEVEL_SELECT,
@@ -21,12 +33,39 @@ struct SDLState {
     GameState gameState = GameState::MAIN_MENU;
     TTF_Font* font = nullptr;
     TTF_Font* fontSmall = nullptr;
+    FontManager* fonts = nullptr; //Owns font and fontSmall, hands out other sizes on demand
+    TextRenderer* text = nullptr; //Atlas-backed text drawing shared by every scene
+    StringTable* strings = nullptr; //Localized strings and their pre-shaped text
+    TextureCache* textures = nullptr; //Shared textures, load through this instead of IMG_LoadTexture
+    AssetLoader* assets = nullptr; //Background reads and decodes for the texture cache
+    Clock* clock = nullptr; //Time sampled by the game loop, read this instead of SDL_GetTicks
+    FramePacer* pacer = nullptr; //Mark it dirty when the screen changes outside of input and loading
+    DisplaySettings* display = nullptr; //Fullscreen type and refresh rate
+    PowerPolicy* power = nullptr; //How much to throttle menus to save battery
+    Simulation* simulation = nullptr; //Runs ticks and input off the main thread, see queueOnMainThread
+    JobSystem* jobs = nullptr; //Worker threads for CPU work, queueOnMainThread for anything touching the renderer
     int width = 1600;
     int height = 900;
     int logW = 800;
     int logH = 450;
 };
 
+//Blends the state left by the previous update with the current one, t from 0 to 1
+inline float interpolate(float previous, float current, float t)
+{
+    return previous + (current - previous) * t;
+}
+
+inline SDL_FRect interpolate(const SDL_FRect& previous, const SDL_FRect& current, float t)
+{
+    return {
+        interpolate(previous.x, current.x, t),
+        interpolate(previous.y, current.y, t),
+        interpolate(previous.w, current.w, t),
+        interpolate(previous.h, current.h, t)
+    };
+}
+
 struct Ingredient {
     string name;
     int quantity = 0;
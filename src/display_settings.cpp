@@ -0,0 +1,150 @@
+#include <cmath>
+#include <iostream>
+#include "display_settings.h"
+
+DisplaySettings::DisplaySettings(SDL_Window* window, FullscreenType type, float refreshRate)
+    : window(window), type(type), refreshRate(refreshRate)
+{
+}
+
+vector<SDL_DisplayMode> DisplaySettings::getModes() const
+{
+    vector<SDL_DisplayMode> modes;
+    int count = 0;
+    SDL_DisplayMode** list = SDL_GetFullscreenDisplayModes(SDL_GetDisplayForWindow(window), &count);
+    if (!list) {
+        cout << "Error listing display modes: " << SDL_GetError() << endl;
+        return modes;
+    }
+    for (int i = 0; i < count; i++) {
+        modes.push_back(*list[i]);
+    }
+    SDL_free(list);
+    return modes;
+}
+
+void DisplaySettings::logModes() const
+{
+    vector<SDL_DisplayMode> modes = getModes();
+    cout << "Fullscreen modes:";
+    for (const SDL_DisplayMode& mode : modes) {
+        cout << " " << mode.w << "x" << mode.h << "@" << mode.refresh_rate;
+    }
+    cout << endl;
+}
+
+void DisplaySettings::setFullscreen(bool fullscreen)
+{
+    if (fullscreen) {
+        applyMode();
+    }
+    if (!SDL_SetWindowFullscreen(window, fullscreen)) {
+        cout << "Error switching fullscreen: " << SDL_GetError() << endl;
+    }
+}
+
+void DisplaySettings::toggleFullscreen()
+{
+    setFullscreen(!isFullscreen());
+}
+
+bool DisplaySettings::isFullscreen() const
+{
+    return (SDL_GetWindowFlags(window) & SDL_WINDOW_FULLSCREEN) != 0;
+}
+
+void DisplaySettings::setType(FullscreenType type)
+{
+    this->type = type;
+    if (isFullscreen()) {
+        applyMode();
+    }
+}
+
+const char* DisplaySettings::getTypeName(FullscreenType type)
+{
+    return type == FullscreenType::Exclusive ? "exclusive" : "borderless";
+}
+
+void DisplaySettings::setRefreshRate(float refreshRate)
+{
+    this->refreshRate = refreshRate;
+    if (isFullscreen() && type == FullscreenType::Exclusive) {
+        applyMode();
+    }
+}
+
+vector<float> DisplaySettings::getRefreshRates() const
+{
+    vector<float> rates;
+    const SDL_DisplayMode* desktop = SDL_GetDesktopDisplayMode(SDL_GetDisplayForWindow(window));
+    if (!desktop) {
+        cout << "Error reading the desktop mode: " << SDL_GetError() << endl;
+        return rates;
+    }
+
+    //SDL lists the modes of one resolution fastest first, formats may repeat a rate
+    for (const SDL_DisplayMode& mode : getModes()) {
+        if (mode.w != desktop->w || mode.h != desktop->h || mode.pixel_density != desktop->pixel_density) continue;
+        if (rates.empty() || rates.back() != mode.refresh_rate) {
+            rates.push_back(mode.refresh_rate);
+        }
+    }
+    return rates;
+}
+
+void DisplaySettings::cycleRefreshRate()
+{
+    vector<float> rates = getRefreshRates();
+    if (rates.empty()) return;
+
+    //The rate applyMode() would pick now, the fastest for 0
+    size_t current = 0;
+    if (refreshRate > 0.0f) {
+        for (size_t i = 1; i < rates.size(); i++) {
+            if (fabsf(rates[i] - refreshRate) < fabsf(rates[current] - refreshRate)) {
+                current = i;
+            }
+        }
+    }
+    setRefreshRate(rates[(current + 1) % rates.size()]);
+}
+
+//Sets the mode the window uses when fullscreen, takes effect right away if it already is
+bool DisplaySettings::applyMode()
+{
+    if (type == FullscreenType::Borderless) {
+        return SDL_SetWindowFullscreenMode(window, nullptr);
+    }
+
+    const SDL_DisplayMode* desktop = SDL_GetDesktopDisplayMode(SDL_GetDisplayForWindow(window));
+    if (!desktop) {
+        cout << "Error reading the desktop mode: " << SDL_GetError() << endl;
+        return false;
+    }
+
+    //Keep the desktop resolution so the art isn't rescaled, only the refresh rate changes
+    vector<SDL_DisplayMode> modes = getModes();
+    const SDL_DisplayMode* best = nullptr;
+    for (const SDL_DisplayMode& mode : modes) {
+        if (mode.w != desktop->w || mode.h != desktop->h || mode.pixel_density != desktop->pixel_density) continue;
+        if (!best) {
+            best = &mode;
+        }
+        else if (refreshRate <= 0.0f ? mode.refresh_rate > best->refresh_rate
+            : fabsf(mode.refresh_rate - refreshRate) < fabsf(best->refresh_rate - refreshRate)) {
+            best = &mode;
+        }
+    }
+    if (!best) {
+        cout << "No fullscreen mode at " << desktop->w << "x" << desktop->h << ", using borderless" << endl;
+        return SDL_SetWindowFullscreenMode(window, nullptr);
+    }
+
+    cout << "Exclusive fullscreen at " << best->w << "x" << best->h << "@" << best->refresh_rate << endl;
+    if (!SDL_SetWindowFullscreenMode(window, best)) {
+        cout << "Error setting fullscreen mode: " << SDL_GetError() << endl;
+        return false;
+    }
+    return true;
+}
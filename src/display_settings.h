@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+using namespace std;
+
+enum class FullscreenType {
+    Borderless, // a desktop sized window, the compositor still presents it
+    Exclusive   // the display switches to our mode and we present straight to it
+};
+
+// Switches the window between windowed, borderless and exclusive fullscreen.
+// Exclusive fullscreen skips the compositor, taking a frame or more off the input lag,
+// and can run the display at a refresh rate other than the desktop's.
+// Switching only resizes the window, scenes pick that up from the resize event.
+class DisplaySettings {
+public:
+    DisplaySettings(SDL_Window* window, FullscreenType type, float refreshRate);
+
+    // Fullscreen modes of the display the window is on, largest and fastest first
+    vector<SDL_DisplayMode> getModes() const;
+    void logModes() const;
+
+    void setFullscreen(bool fullscreen);
+    void toggleFullscreen();
+    bool isFullscreen() const;
+
+    // Applied straight away when already fullscreen
+    void setType(FullscreenType type);
+    FullscreenType getType() const { return type; }
+    static const char* getTypeName(FullscreenType type);
+    // Refresh rate for exclusive fullscreen at the desktop resolution, the nearest one the
+    // display has. 0 picks the fastest. Applied straight away when in exclusive fullscreen.
+    void setRefreshRate(float refreshRate);
+    float getRefreshRate() const { return refreshRate; }
+    // Refresh rates the display has at the desktop resolution, fastest first
+    vector<float> getRefreshRates() const;
+    // Steps to the next slower of those, from the slowest back to the fastest
+    void cycleRefreshRate();
+
+private:
+    bool applyMode();
+
+    SDL_Window* window;
+    FullscreenType type;
+    float refreshRate;
+};
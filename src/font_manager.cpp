@@ -0,0 +1,118 @@
+#include "font_manager.h"
+#include <iostream>
+
+using namespace std;
+
+FontManager::~FontManager()
+{
+    for (auto& pair : faces) {
+        for (auto& size : pair.second.sizes) {
+            TTF_CloseFont(size.second);
+        }
+        SDL_free(pair.second.data);
+    }
+    faces.clear();
+}
+
+//Reads a font file into memory the first time it is asked for
+FontManager::Face* FontManager::loadFace(const string& path)
+{
+    auto it = faces.find(path);
+    if (it != faces.end()) {
+        return &it->second;
+    }
+
+    size_t dataSize = 0;
+    void* data = SDL_LoadFile(path.c_str(), &dataSize);
+    if (!data) {
+        cout << "Error loading font " << path << ": " << SDL_GetError() << endl;
+        return nullptr;
+    }
+
+    Face& face = faces[path];
+    face.data = data;
+    face.dataSize = dataSize;
+    return &face;
+}
+
+TTF_Font* FontManager::getFont(const string& path, float ptsize)
+{
+    Face* face = loadFace(path);
+    if (!face) return nullptr;
+
+    auto it = face->sizes.find(ptsize);
+    if (it != face->sizes.end()) {
+        return it->second;
+    }
+
+    //The stream only wraps the shared file data, closing it does not free anything
+    SDL_IOStream* stream = SDL_IOFromConstMem(face->data, face->dataSize);
+    TTF_Font* font = stream ? TTF_OpenFontIO(stream, true, ptsize) : nullptr;
+    if (!font) {
+        cout << "Error opening font " << path << " at size " << ptsize << ": " << SDL_GetError() << endl;
+        return nullptr;
+    }
+
+    face->sizes[ptsize] = font;
+    return font;
+}
+
+TTF_Font* FontManager::getSizedFont(TTF_Font* font, float ptsize)
+{
+    for (auto& pair : faces) {
+        for (auto& size : pair.second.sizes) {
+            if (size.second == font) {
+                return getFont(pair.first, ptsize);
+            }
+        }
+    }
+    return nullptr;
+}
+
+void FontManager::closeFont(const string& path, float ptsize)
+{
+    auto faceIt = faces.find(path);
+    if (faceIt == faces.end()) return;
+
+    auto sizeIt = faceIt->second.sizes.find(ptsize);
+    if (sizeIt == faceIt->second.sizes.end()) return;
+
+    TTF_CloseFont(sizeIt->second);
+    faceIt->second.sizes.erase(sizeIt);
+}
+
+//Estimates what rasterizing printable ASCII at this size costs, from metrics alone
+size_t FontManager::estimateGlyphBytes(TTF_Font* font)
+{
+    size_t bytes = 0;
+    for (Uint32 ch = 32; ch < 127; ch++) {
+        int minx = 0, maxx = 0, miny = 0, maxy = 0;
+        if (TTF_GetGlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, nullptr)) {
+            bytes += static_cast<size_t>(max(0, maxx - minx)) * static_cast<size_t>(max(0, maxy - miny));
+        }
+    }
+    return bytes;
+}
+
+vector<FontManager::FaceUsage> FontManager::getMemoryUsage() const
+{
+    vector<FaceUsage> usage;
+    for (const auto& pair : faces) {
+        FaceUsage face{ pair.first, pair.second.dataSize, {} };
+        for (const auto& size : pair.second.sizes) {
+            face.sizes.push_back({ size.first, estimateGlyphBytes(size.second) });
+        }
+        usage.push_back(face);
+    }
+    return usage;
+}
+
+void FontManager::logMemoryUsage() const
+{
+    for (const FaceUsage& face : getMemoryUsage()) {
+        cout << "Font " << face.path << ": " << face.fileBytes << " bytes of font data" << endl;
+        for (const SizeUsage& size : face.sizes) {
+            cout << "    " << size.ptsize << "pt: ~" << size.glyphBytes << " bytes of glyphs" << endl;
+        }
+    }
+}
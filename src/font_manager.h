@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Owns every font in the game.
+// Each font file is read into memory once and every size of it is opened from
+// that shared copy, so asking for a new size never touches the disk again.
+// Fonts handed out stay valid until closeFont() or the manager is destroyed.
+class FontManager {
+public:
+    FontManager() = default;
+    ~FontManager();
+    FontManager(const FontManager&) = delete;
+    FontManager& operator=(const FontManager&) = delete;
+
+    TTF_Font* getFont(const string& path, float ptsize);
+    // Same face as an already opened font, at another size
+    TTF_Font* getSizedFont(TTF_Font* font, float ptsize);
+    // Only for sizes nothing is drawing with anymore
+    void closeFont(const string& path, float ptsize);
+
+    struct SizeUsage {
+        float ptsize;
+        size_t glyphBytes; // estimated 8-bit coverage for printable ASCII
+    };
+    struct FaceUsage {
+        string path;
+        size_t fileBytes;
+        vector<SizeUsage> sizes;
+    };
+    vector<FaceUsage> getMemoryUsage() const;
+    void logMemoryUsage() const;
+
+private:
+    struct Face {
+        void* data = nullptr;
+        size_t dataSize = 0;
+        map<float, TTF_Font*> sizes;
+    };
+
+    Face* loadFace(const string& path);
+    static size_t estimateGlyphBytes(TTF_Font* font);
+
+    unordered_map<string, Face> faces;
+};
@@ -0,0 +1,134 @@
+#include <iostream>
+#include "frame_pacer.h"
+#if defined(SDL_PLATFORM_WINDOWS)
+#include <d3d11.h>
+#endif
+
+FramePacer::FramePacer(SDL_Renderer* renderer, PacingMode mode, int capFPS)
+    : renderer(renderer), mode(mode), frameNS(SDL_NS_PER_SECOND / SDL_max(capFPS, 1))
+{
+    setMode(mode);
+}
+
+void FramePacer::setMode(PacingMode mode)
+{
+    this->mode = mode;
+    applyVSync();
+    nextFrameNS = SDL_GetTicksNS();
+    dirty = true;
+}
+
+void FramePacer::setVSync(int vsync)
+{
+    this->vsync = vsync;
+    applyVSync();
+    dirty = true;
+}
+
+void FramePacer::applyVSync()
+{
+    //Capped does its own waiting, vsync would round it to a multiple of the refresh interval
+    int wanted = mode == PacingMode::Capped ? 0 : vsync;
+    if (!SDL_SetRenderVSync(renderer, wanted)) {
+        cout << "Vsync " << wanted << " not supported, using 1: " << SDL_GetError() << endl;
+        vsync = 1;
+        SDL_SetRenderVSync(renderer, 1);
+    }
+}
+
+const char* FramePacer::getModeName(PacingMode mode)
+{
+    switch (mode) {
+    case PacingMode::VSync:
+        return "vsync";
+    case PacingMode::Capped:
+        return "capped";
+    case PacingMode::OnDemand:
+        return "on demand";
+    }
+    return "unknown";
+}
+
+void FramePacer::setFrameLimit(int fps)
+{
+    limitNS = fps > 0 ? SDL_NS_PER_SECOND / fps : 0;
+}
+
+void FramePacer::setHidden(bool hidden)
+{
+    this->hidden = hidden;
+    dirty = true; //Draw straight away when it shows again
+}
+
+bool FramePacer::waitIfIdle()
+{
+    bool idle = hidden || (mode == PacingMode::OnDemand && !dirty);
+    if (!idle) return false;
+    SDL_WaitEventTimeout(nullptr, IDLE_WAIT_MS); //Leaves the event in the queue for the loop
+    return true;
+}
+
+bool FramePacer::beginFrame()
+{
+    drawing = !hidden && (mode != PacingMode::OnDemand || dirty);
+    if (drawing) {
+        dirty = false;
+    }
+    return drawing;
+}
+
+void FramePacer::setLimitQueuedFrames(bool limit)
+{
+    limitQueuedFrames = limit;
+    bool limited = setMaxFrameLatency(limit ? 1 : DEFAULT_FRAME_LATENCY);
+    syncEveryFrame = limit && !limited;
+    if (syncEveryFrame) {
+        const char* name = SDL_GetStringProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_NAME_STRING, "this renderer");
+        cout << "Can't limit queued frames on " << name << ", waiting for the GPU every frame instead" << endl;
+    }
+}
+
+//Sets how many frames the driver may queue, returns false when the renderer doesn't let us
+bool FramePacer::setMaxFrameLatency(int frames)
+{
+#if defined(SDL_PLATFORM_WINDOWS)
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    ID3D11Device* device = static_cast<ID3D11Device*>(SDL_GetPointerProperty(props, SDL_PROP_RENDERER_D3D11_DEVICE_POINTER, nullptr));
+    if (!device) return false;
+
+    IDXGIDevice1* dxgiDevice = nullptr;
+    if (FAILED(device->QueryInterface(__uuidof(IDXGIDevice1), reinterpret_cast<void**>(&dxgiDevice)))) return false;
+    HRESULT result = dxgiDevice->SetMaximumFrameLatency(static_cast<UINT>(frames));
+    dxgiDevice->Release();
+    return SUCCEEDED(result);
+#else
+    (void)frames;
+    return false;
+#endif
+}
+
+void FramePacer::present()
+{
+    if (syncEveryFrame) {
+        //Reading a pixel back can't finish before the GPU has drawn everything queued before it
+        SDL_Rect pixel = { 0, 0, 1, 1 };
+        SDL_Surface* readback = SDL_RenderReadPixels(renderer, &pixel);
+        SDL_DestroySurface(readback);
+    }
+    SDL_RenderPresent(renderer);
+}
+
+void FramePacer::endFrame()
+{
+    Uint64 interval = SDL_max(mode == PacingMode::Capped ? frameNS : 0, limitNS);
+    if (!drawing || interval == 0) return;
+
+    nextFrameNS += interval;
+    Uint64 now = SDL_GetTicksNS();
+    if (now < nextFrameNS) {
+        SDL_DelayPrecise(nextFrameNS - now);
+    }
+    else {
+        nextFrameNS = now; //Running behind, don't try to make the time up with short frames
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+
+using namespace std;
+
+enum class PacingMode {
+    VSync,    // present every frame, waiting for the display's refresh
+    Capped,   // no vsync, sleep precisely to a fixed frame rate
+    OnDemand  // wait for events and only draw frames a scene has marked dirty
+};
+
+// Decides when the game loop draws and how it waits between frames.
+// In OnDemand mode a static screen costs nothing: the loop blocks in SDL_WaitEventTimeout
+// until input arrives, and skips drawing unless an event, a finished texture load, a
+// simulation tick or a scene calling markDirty() changed something. Scenes that animate mark themselves dirty
+// every frame they draw.
+class FramePacer {
+public:
+    FramePacer(SDL_Renderer* renderer, PacingMode mode, int capFPS);
+
+    void setMode(PacingMode mode);
+    PacingMode getMode() const { return mode; }
+    static const char* getModeName(PacingMode mode);
+
+    // Vsync used by the VSync and OnDemand modes: 0 off, 1 every refresh, 2 every other one
+    // and so on, or SDL_RENDERER_VSYNC_ADAPTIVE to tear rather than wait when a frame is late.
+    // Falls back to 1 when the renderer doesn't support the value.
+    void setVSync(int vsync);
+    int getVSync() const { return vsync; }
+    // Lets the driver queue only one frame ahead of the display, for a frame or two less
+    // of input lag. Only Direct3D 11 exposes that through SDL's renderer. On every other
+    // backend it is a debug option instead: present() reads a pixel back, which makes the
+    // CPU wait for the GPU to finish every frame. That stalls both of them, so it costs
+    // throughput and says nothing about queue depth. Apply again after a device reset.
+    void setLimitQueuedFrames(bool limit);
+    bool getLimitQueuedFrames() const { return limitQueuedFrames; }
+
+    // Caps the frame rate below what the mode gives, 0 for no cap. Used to save power.
+    void setFrameLimit(int fps);
+    // Nothing is drawn while the window can't be seen, the loop just waits for events
+    void setHidden(bool hidden);
+    bool isHidden() const { return hidden; }
+
+    // The next frame has to be drawn. Safe from any thread. Returns false if it already was dirty.
+    bool markDirty() { return !dirty.exchange(true); }
+
+    // While hidden, or in OnDemand mode with nothing dirty, blocks until an event arrives or
+    // IDLE_WAIT_MS passes. Returns true if it waited.
+    bool waitIfIdle();
+    // Whether to draw this frame. Anything marked dirty while drawing it is drawn next frame.
+    bool beginFrame();
+    // Presents the frame drawn after beginFrame()
+    void present();
+    // Sleeps until the next frame is due in Capped mode or under a frame limit
+    void endFrame();
+
+private:
+    void applyVSync();
+    bool setMaxFrameLatency(int frames);
+
+    static const Uint32 IDLE_WAIT_MS = 500; // wakes up now and then even without events, to run a tick
+    static const int DEFAULT_FRAME_LATENCY = 3; // what Direct3D queues when left alone
+
+    SDL_Renderer* renderer;
+    PacingMode mode;
+    Uint64 frameNS;
+    Uint64 limitNS = 0;
+    Uint64 nextFrameNS = 0;
+    int vsync = 1;
+    bool limitQueuedFrames = false;
+    bool syncEveryFrame = false; // the backend can't limit the queue, stall on the GPU instead
+    atomic<bool> dirty{ true }; // set by the simulation thread too
+    bool hidden = false;
+    bool drawing = false; // beginFrame() said to draw
+};
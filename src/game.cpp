@@ -7,6 +7,18 @@
 #include "menu.h"
 #include "level_manager.h"
 #include "data_structs.h"
+#include "text_renderer.h"
+#include "font_manager.h"
+#include "string_table.h"
+#include "text_label.h"
+#include "texture_cache.h"
+#include "asset_loader.h"
+#include "clock.h"
+#include "frame_pacer.h"
+#include "display_settings.h"
+#include "power_policy.h"
+#include "simulation.h"
+#include "job_system.h"
 
 using namespace std;
 
@@ -24,69 +36,178 @@ void Game::startGame()
 	Menu mainMenu(state);
 	LevelManager levelManager(state);
 
-
-	uint64_t nextGameTick = SDL_GetTicks();
-	int loops;
+	//Ticks and input run on their own thread, TICKS_PER_SECOND times per second
+	Simulation simulation(state.clock, state.pacer, state.jobs, SKIP_TICKS_NS, MAX_FRAMESKIP,
+		[&](const SDL_Event& event) {
+			if (state.gameState == GameState::MAIN_MENU) {
+				mainMenu.handleEvent(event);
+			}
+			else if (state.gameState == GameState::PLAYING) {
+				levelManager.handleEvent(event);
+			}
+		},
+		[&]() {
+			//Update game logic (anything not tied to visuals, eg. physics)
+			if (state.gameState == GameState::MAIN_MENU) {
+				mainMenu.update(); //Only changes on input
+			}
+			else if (state.gameState == GameState::PLAYING) {
+				return levelManager.update();
+			}
+			return false;
+		});
+	state.simulation = &simulation;
+	if (!simulation.start()) {
+		cleanup();
+		exit(1);
+	}
 
 	//start the game loop
 	bool running = true;
 	while (running) {
+		state.pacer->waitIfIdle();
+
 		//Event Handling
 		SDL_Event event{ 0 };
 		while (SDL_PollEvent(&event)) {
+			if (event.type == state.jobs->getWakeEventType()) {
+				continue; //Only there to end waitIfIdle, the work is run below
+			}
 			// Convert event coordinates to logical render coordinates
 			SDL_ConvertEventToRenderCoordinates(state.renderer, &event);
+			state.pacer->markDirty(); //Input can change anything on screen
 			switch (event.type) {
 			case SDL_EVENT_QUIT:
 				running = false;
 				break;
+			case SDL_EVENT_RENDER_DEVICE_RESET: //A new device starts with the driver's frame latency
+				state.pacer->setLimitQueuedFrames(state.pacer->getLimitQueuedFrames());
+				break;
+			case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED: //Resizes, fullscreen toggles and display scale changes
+				if (state.textures) {
+					state.textures->updateOutputSize();
+				}
+				break;
 			case SDL_EVENT_KEY_DOWN:
-				if (event.key.key == SDLK_F11) { // Toggle fullscreen
-					SDL_WindowFlags flags = SDL_GetWindowFlags(state.window);
-					bool isFullscreen = flags & SDL_WINDOW_FULLSCREEN;
-					SDL_SetWindowFullscreen(state.window, !isFullscreen);
+				if (event.key.key == SDLK_F11 && (event.key.mod & SDL_KMOD_CTRL)) { // Cycle the exclusive fullscreen refresh rate
+					state.display->cycleRefreshRate();
+					cout << "Exclusive fullscreen refresh rate: " << state.display->getRefreshRate() << " Hz" << endl;
+				}
+				else if (event.key.key == SDLK_F11 && (event.key.mod & SDL_KMOD_SHIFT)) { // Switch borderless and exclusive fullscreen
+					FullscreenType type = state.display->getType() == FullscreenType::Exclusive ? FullscreenType::Borderless : FullscreenType::Exclusive;
+					state.display->setType(type);
+					cout << "Fullscreen: " << DisplaySettings::getTypeName(type) << endl;
+				}
+				else if (event.key.key == SDLK_F11) { // Toggle fullscreen
+					state.display->toggleFullscreen();
+				}
+				else if (event.key.key == SDLK_F6 && (event.key.mod & SDL_KMOD_SHIFT)) { // Toggle the queued frame limit
+					state.pacer->setLimitQueuedFrames(!state.pacer->getLimitQueuedFrames());
+					cout << "Limit queued frames: " << (state.pacer->getLimitQueuedFrames() ? "on" : "off") << endl;
+				}
+				else if (event.key.key == SDLK_F6) { // Cycle vsync: every refresh, every other, adaptive, off
+					int vsync = state.pacer->getVSync();
+					int next = vsync == 1 ? 2 : vsync == 2 ? SDL_RENDERER_VSYNC_ADAPTIVE : vsync == SDL_RENDERER_VSYNC_ADAPTIVE ? 0 : 1;
+					state.pacer->setVSync(next);
+					cout << "Vsync: " << state.pacer->getVSync() << endl;
+				}
+				else if (event.key.key == SDLK_F8 && state.strings) { // Cycle language
+					state.strings->cycleLanguage();
+				}
+				else if (event.key.key == SDLK_F4) { // HUD text layouts so far
+					cout << "HUD text rebuilds so far: " << TextLabel::getRebuildCount() << endl;
+				}
+				else if (event.key.key == SDLK_F5) { // Time spent in each kind of job
+					state.jobs->logStats();
+				}
+				else if (event.key.key == SDLK_F9 && state.textures) { // Texture memory per scene
+					state.textures->logUsage();
+				}
+				else if (event.key.key == SDLK_F7) { // Cycle frame pacing
+					PacingMode mode = static_cast<PacingMode>((static_cast<int>(state.pacer->getMode()) + 1) % 3);
+					state.pacer->setMode(mode);
+					cout << "Frame pacing: " << FramePacer::getModeName(mode) << endl;
+				}
+				else if (event.key.key == SDLK_F10) { // Switch PNG decoder
+					ImageDecoder decoder = getImageDecoder() == ImageDecoder::Fast ? ImageDecoder::SDLImage : ImageDecoder::Fast;
+					setImageDecoder(decoder);
+					cout << "Decoding images with " << getImageDecoderName(decoder) << endl;
 				}
 				break;
 			}
 
-			if (state.gameState == GameState::MAIN_MENU) {
-				mainMenu.handleEvent(event);
+			//Input is applied on the simulation thread, window events are handled here
+			if (Simulation::isInputEvent(event)) {
+				simulation.queueInput(event);
 			}
-			else if (state.gameState == GameState::PLAYING) {
-				levelManager.handleEvent(event);
+			else {
+				simulation.lock();
+				state.power->handleEvent(event); //Stops drawing and timers while the window can't be seen
+				if (state.gameState == GameState::MAIN_MENU) {
+					mainMenu.handleEvent(event);
+				}
+				else if (state.gameState == GameState::PLAYING) {
+					levelManager.handleEvent(event);
+				}
+				simulation.unlock();
 			}
 		}
 
-		//Executes TICKS_PER_SECOND times per second
-		loops = 0;
-		while (SDL_GetTicks() > nextGameTick && loops < MAX_FRAMESKIP) {
-			//Update game logic (anything not tied to visuals, eg. physics)
-			if (state.gameState == GameState::MAIN_MENU) {
-				mainMenu.update();
-			}
-			else if (state.gameState == GameState::PLAYING) {
-				levelManager.update();
+		//Minigame changes the simulation thread queued during its last ticks, and continuations
+		//background jobs left for the main thread, in the order they were queued.
+		//Not locked, they load textures and only lock the world to swap what they built in.
+		bool ranJobs = state.jobs->pumpMainThread(MAIN_THREAD_JOB_BUDGET_NS);
+		if (ranJobs) {
+			state.pacer->markDirty();
+		}
+
+		//Hand finished background loads to the GPU
+		if (state.assets) {
+			if (state.assets->getPendingCount() > 0) {
+				state.pacer->markDirty(); //Thumbnails and placeholders get swapped for the real thing
 			}
-			nextGameTick += SKIP_TICKS;
-			loops++;
+			state.assets->pump(UPLOAD_BUDGET_NS);
+		}
+		if (state.textures) {
+			state.textures->beginFrame();
 		}
 
-		//Game Renderering
+		//Menus and level select draw less often on battery, minigames never do
+		state.power->update();
+		simulation.lock();
+		bool inMinigame = state.gameState == GameState::PLAYING && levelManager.isPlaying();
+		simulation.unlock();
+		state.pacer->setFrameLimit(inMinigame ? 0 : state.power->getProfile().menuFrameCap);
 
-		//Set color to white and clear screen
-		SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
-		SDL_RenderClear(state.renderer);
+		//Game Renderering, skipped when nothing on screen changed and pacing is on demand
+		if (state.pacer->beginFrame()) {
+			//Scenes are only locked while their draw calls are recorded, not while presenting
+			simulation.lock();
+			state.clock->sample(); //Drawing this frame sees this time
 
-		if (state.gameState == GameState::MAIN_MENU) {
-			mainMenu.render();
-		}
-		else if (state.gameState == GameState::PLAYING) {
-			levelManager.render();
-		}
+			//How far between the last update and the next one this frame is, rendering blends by it
+			Sint64 sinceUpdate = static_cast<Sint64>(state.clock->realNS()) - static_cast<Sint64>(simulation.getLastTickNS());
+			float alpha = SDL_clamp(static_cast<float>(sinceUpdate) / SKIP_TICKS_NS, 0.0f, 1.0f);
 
-		//swap buffers and present
-		SDL_RenderPresent(state.renderer);;
+			//Set color to white and clear screen
+			SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+			SDL_RenderClear(state.renderer);
+
+			if (state.gameState == GameState::MAIN_MENU) {
+				mainMenu.render();
+			}
+			else if (state.gameState == GameState::PLAYING) {
+				levelManager.render(alpha);
+			}
+			simulation.unlock();
+
+			//swap buffers and present
+			state.pacer->present();
+		}
+		state.pacer->endFrame();
 	}
+	simulation.stop();
+	state.simulation = nullptr;
 	cleanup();
 	exit(0);
 }
@@ -100,6 +221,13 @@ bool Game::initialize() {
 		SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error initializing SDL3", nullptr);
 		initSuccess = false;
 	}
+	state.clock = new Clock();
+
+	int jobWorkers = JOB_WORKERS;
+	if (const char* workersOverride = SDL_getenv("JOB_WORKERS")) {
+		jobWorkers = SDL_atoi(workersOverride);
+	}
+	state.jobs = new JobSystem(jobWorkers);
 
 	//create the window
 	state.window = SDL_CreateWindow("Cooking Mama Clone", state.width, state.height, SDL_WINDOW_RESIZABLE);
@@ -110,16 +238,57 @@ bool Game::initialize() {
 	}
 	else {
 		SDL_SetWindowAspectRatio(state.window, 16.0f / 9.0f, 16.0f / 9.0f);
+
+		FullscreenType fullscreenType = FULLSCREEN_TYPE;
+		if (const char* typeOverride = SDL_getenv("FULLSCREEN")) {
+			if (SDL_strcasecmp(typeOverride, "borderless") == 0) fullscreenType = FullscreenType::Borderless;
+			else if (SDL_strcasecmp(typeOverride, "exclusive") == 0) fullscreenType = FullscreenType::Exclusive;
+		}
+		float refreshRate = FULLSCREEN_REFRESH_HZ;
+		if (const char* refreshOverride = SDL_getenv("FULLSCREEN_REFRESH")) {
+			refreshRate = static_cast<float>(SDL_atof(refreshOverride));
+		}
+		state.display = new DisplaySettings(state.window, fullscreenType, refreshRate);
+		if (fullscreenType == FullscreenType::Exclusive) {
+			state.display->logModes();
+		}
 	}
 
 	//Create the renderer
 	state.renderer = SDL_CreateRenderer(state.window, nullptr);
-	SDL_SetRenderVSync(state.renderer, 1);  // Enable VSync
 	if (!state.renderer) {
 		SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error creating renderer", state.window);
 		cleanup();
 		initSuccess = false;
 	}
+	else {
+		//Sets up vsync to match the pacing mode
+		PacingMode pacing = PACING_MODE;
+		if (const char* pacingOverride = SDL_getenv("FRAME_PACING")) {
+			if (SDL_strcasecmp(pacingOverride, "vsync") == 0) pacing = PacingMode::VSync;
+			else if (SDL_strcasecmp(pacingOverride, "cap") == 0) pacing = PacingMode::Capped;
+			else if (SDL_strcasecmp(pacingOverride, "ondemand") == 0) pacing = PacingMode::OnDemand;
+		}
+		int capFPS = FRAME_CAP_FPS;
+		if (const char* capOverride = SDL_getenv("FRAME_CAP")) {
+			capFPS = SDL_atoi(capOverride);
+		}
+		state.pacer = new FramePacer(state.renderer, pacing, capFPS);
+
+		int vsync = VSYNC;
+		if (const char* vsyncOverride = SDL_getenv("VSYNC")) {
+			if (SDL_strcasecmp(vsyncOverride, "off") == 0) vsync = 0;
+			else if (SDL_strcasecmp(vsyncOverride, "adaptive") == 0) vsync = SDL_RENDERER_VSYNC_ADAPTIVE;
+			else vsync = SDL_atoi(vsyncOverride);
+		}
+		state.pacer->setVSync(vsync);
+		bool limitQueuedFrames = LIMIT_QUEUED_FRAMES;
+		if (const char* limitOverride = SDL_getenv("LIMIT_QUEUED_FRAMES")) {
+			limitQueuedFrames = SDL_atoi(limitOverride) != 0;
+		}
+		state.pacer->setLimitQueuedFrames(limitQueuedFrames);
+		state.power = new PowerPolicy(state.clock, state.pacer);
+	}
 
 	//Initialize SDL_ttf
 	if (!TTF_Init()) {
@@ -128,8 +297,9 @@ bool Game::initialize() {
 		initSuccess = false;
 	}
 
-	//Load the font
-	state.font = TTF_OpenFont("src/res/fonts/BloodyModes.ttf", 28);  // 32 is font size
+	//Load the font, the file is only read once and shared by every size
+	state.fonts = new FontManager();
+	state.font = state.fonts->getFont("src/res/fonts/BloodyModes.ttf", 28);  // 28 is font size
 	if (!state.font) {
 		SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error initializing SDL_ttf", state.window);
 		TTF_Quit();
@@ -138,7 +308,7 @@ bool Game::initialize() {
 	}
 
 	//Load the smaller font for non-selected cards
-	state.fontSmall = TTF_OpenFont("src/res/fonts/BloodyModes.ttf", 20); 
+	state.fontSmall = state.fonts->getFont("src/res/fonts/BloodyModes.ttf", 20);
 	if (!state.fontSmall) {
 		SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Error initializing SDL_ttf for small font", state.window);
 		TTF_Quit();
@@ -146,16 +316,59 @@ bool Game::initialize() {
 		initSuccess = false;
 	}
 
+	//Create the text engine that caches glyphs in a shared atlas, and the texture cache
+	if (state.renderer) {
+		initImageDecoder(state.renderer, IMAGE_DECODER); //Before any loads start
+		state.assets = new AssetLoader(state.renderer, state.jobs);
+		state.textures = new TextureCache(state.renderer, state.assets);
+
+		int budgetMB = TEXTURE_BUDGET_MB;
+		if (const char* budgetOverride = SDL_getenv("TEXTURE_BUDGET_MB")) {
+			budgetMB = SDL_atoi(budgetOverride);
+		}
+		state.textures->setBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+		state.text = new TextRenderer(state.renderer);
+		state.strings = new StringTable(state.text);
+		state.strings->selectPreferredLanguage();
+	}
+
 	//Configure presentation
 	SDL_SetRenderLogicalPresentation(state.renderer, state.logW, state.logH, SDL_LOGICAL_PRESENTATION_OVERSCAN);
+	if (state.textures) {
+		state.textures->updateOutputSize(); //Texture resolution follows the window's pixel size
+	}
+
+	if (state.fonts) {
+		state.fonts->logMemoryUsage();
+	}
 
 	return initSuccess;
 }
 
 void Game::cleanup() {
+	delete state.strings;
+	state.strings = nullptr;
+	delete state.assets; //Drops loads in flight before the cache their callbacks point into
+	state.assets = nullptr;
+	delete state.jobs; //Finishes the jobs already started, after the loader waits for its decodes
+	state.jobs = nullptr;
+	delete state.textures;
+	state.textures = nullptr;
+	delete state.text; //Text objects must go before their fonts and renderer
+	state.text = nullptr;
+	delete state.power;
+	state.power = nullptr;
+	delete state.pacer;
+	state.pacer = nullptr;
+	delete state.display;
+	state.display = nullptr;
 	SDL_DestroyRenderer(state.renderer);
 	SDL_DestroyWindow(state.window);
-	TTF_CloseFont(state.font);
-	TTF_CloseFont(state.fontSmall);
+	delete state.fonts; //Closes font, fontSmall and any other sizes handed out
+	state.fonts = nullptr;
+	state.font = nullptr;
+	state.fontSmall = nullptr;
+	delete state.clock;
+	state.clock = nullptr;
 	SDL_Quit();
 }
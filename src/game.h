@@ -8,6 +8,9 @@
 #include "menu.h"
 #include "level_manager.h"
 #include "data_structs.h"
+#include "png_decoder.h"
+#include "frame_pacer.h"
+#include "display_settings.h"
 
 using namespace std;
 
@@ -22,6 +25,17 @@ private:
 	SDLState state;
 	const bool* keys = SDL_GetKeyboardState(nullptr);
 	const int TICKS_PER_SECOND = 50;
-	const int SKIP_TICKS = 1000 / TICKS_PER_SECOND;
+	const Uint64 SKIP_TICKS_NS = SDL_NS_PER_SECOND / TICKS_PER_SECOND;
 	const int MAX_FRAMESKIP = 10;
+	const int TEXTURE_BUDGET_MB = 256; //Cap on texture memory, the TEXTURE_BUDGET_MB environment variable overrides it and 0 turns it off
+	const ImageDecoder IMAGE_DECODER = ImageDecoder::Fast; //PNG decoder, the PNG_DECODER environment variable overrides it and F10 switches
+	const PacingMode PACING_MODE = PacingMode::VSync; //The FRAME_PACING environment variable ("vsync", "cap" or "ondemand") overrides it and F7 cycles
+	const int FRAME_CAP_FPS = 60; //Frame rate in Capped mode, the FRAME_CAP environment variable overrides it
+	const int VSYNC = 1; //0 off, 1 every refresh, 2 every other, SDL_RENDERER_VSYNC_ADAPTIVE. The VSYNC environment variable ("off", "adaptive" or a number) overrides it and F6 cycles
+	const bool LIMIT_QUEUED_FRAMES = false; //Queue one frame at most on Direct3D 11, elsewhere a debug option that waits for the GPU every frame. The LIMIT_QUEUED_FRAMES environment variable overrides it and Shift+F6 toggles
+	const FullscreenType FULLSCREEN_TYPE = FullscreenType::Borderless; //What F11 switches to, the FULLSCREEN environment variable ("borderless" or "exclusive") overrides it and Shift+F11 switches
+	const float FULLSCREEN_REFRESH_HZ = 0.0f; //Exclusive fullscreen refresh rate, 0 for the fastest. The FULLSCREEN_REFRESH environment variable overrides it and Ctrl+F11 cycles through what the display has
+	const Uint64 UPLOAD_BUDGET_NS = 2 * SDL_NS_PER_MS; //Time per frame spent uploading async loaded textures
+	const int JOB_WORKERS = 0; //Job system threads, 0 for one per core the main and simulation threads leave. The JOB_WORKERS environment variable overrides it
+	const Uint64 MAIN_THREAD_JOB_BUDGET_NS = 2 * SDL_NS_PER_MS; //Time per frame spent on jobs queued for the main thread
 };
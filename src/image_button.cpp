@@ -51,17 +51,18 @@ void ImageButton::handleEvent(const SDL_Event& event) {
         break;
     }
 }
-void ImageButton::setTexture(SDL_Texture* texture) {
-    if (buttonTexture) {
-        SDL_DestroyTexture(buttonTexture); 
-    }
-    buttonTexture = texture; // Set texture
+void ImageButton::setTexture(const TextureHandle& texture) {
+    sharedTexture = texture; // Set texture, takes precedence over the one from imagePath
 }
 void ImageButton::render(SDLState& state) {
     SDL_Renderer* renderer = state.renderer;
 
 
-    if (buttonTexture) {
+    if (sharedTexture) {
+        SDL_FRect rect = { x, y, w, h };
+        sharedTexture.render(renderer, nullptr, &rect);
+    }
+    else if (buttonTexture) {
         SDL_FRect rect = { x, y, w, h };
         SDL_RenderTexture(renderer, buttonTexture, nullptr, &rect);
     }
@@ -1,5 +1,6 @@
 #pragma once
 #include "data_structs.h"
+#include "texture_cache.h"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <string>
@@ -12,7 +13,7 @@ public:
     ImageButton(float x, float y, float w, float h, const std::string& text, const std::string& imagePath, ClickCallback onClick = nullptr);
     ~ImageButton();
 
-    void setTexture(SDL_Texture* texture);
+    void setTexture(const TextureHandle& texture); // shared, the button only keeps a reference
     void render(SDLState& state);
     void handleEvent(const SDL_Event& event);
     void setCallback(ClickCallback callback);
@@ -21,7 +22,8 @@ public:
 private:
     float x, y, w, h;
     std::string text;
-    SDL_Texture* buttonTexture;
+    SDL_Texture* buttonTexture; // loaded from imagePath, owned by the button
+    TextureHandle sharedTexture;
     bool isHovered;
     bool isPressed;
     ClickCallback onClick;
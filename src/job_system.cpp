@@ -0,0 +1,340 @@
+#include "job_system.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+struct QueuedJob {
+    const char* name;
+    JobSystem::Work work;
+    JobCounter* counter;
+    bool mainThread;
+};
+
+namespace {
+    //The worker this thread is, nullptr off the pool
+    thread_local void* currentWorker = nullptr;
+
+    //How long wait() sleeps before checking for jobs to help with again
+    const Sint32 WAIT_POLL_MS = 1;
+}
+
+JobSystem::JobSystem(int workerCount)
+{
+    jobsQueued = SDL_CreateSemaphore(0);
+    dependencyMutex = SDL_CreateMutex();
+    mainMutex = SDL_CreateMutex();
+    doneMutex = SDL_CreateMutex();
+    counterDone = SDL_CreateCondition();
+    statsMutex = SDL_CreateMutex();
+    wakeEventType = SDL_RegisterEvents(1);
+    if (!jobsQueued || !dependencyMutex || !mainMutex || !doneMutex || !counterDone || !statsMutex) {
+        cout << "Error creating job system: " << SDL_GetError() << endl;
+        return;
+    }
+
+    //The main thread draws and the simulation thread ticks, the rest of the cores are ours
+    if (workerCount <= 0) {
+        workerCount = SDL_GetNumLogicalCPUCores() - 2;
+    }
+    workerCount = clamp(workerCount, 1, MAX_WORKERS);
+
+    //Every deque exists before any thread starts stealing from them
+    for (int i = 0; i < workerCount; i++) {
+        Worker* worker = new Worker();
+        worker->system = this;
+        worker->index = i;
+        worker->mutex = SDL_CreateMutex();
+        if (!worker->mutex) {
+            cout << "Error creating job worker: " << SDL_GetError() << endl;
+            delete worker;
+            break;
+        }
+        workers.push_back(worker);
+    }
+    int started = 0;
+    for (Worker* worker : workers) {
+        worker->thread = SDL_CreateThread(workerMain, "JobWorker", worker);
+        if (worker->thread) {
+            started++;
+        }
+        else {
+            cout << "Error creating job worker thread: " << SDL_GetError() << endl; //Its deque gets stolen from
+        }
+    }
+
+    //Without any threads jobs run where they are started
+    if (started == 0) {
+        for (Worker* worker : workers) {
+            SDL_DestroyMutex(worker->mutex);
+            delete worker;
+        }
+        workers.clear();
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    //Workers only quit once every deque is empty
+    quitting = true;
+    for (size_t i = 0; i < workers.size(); i++) {
+        SDL_SignalSemaphore(jobsQueued);
+    }
+    for (Worker* worker : workers) {
+        if (worker->thread) SDL_WaitThread(worker->thread, nullptr);
+    }
+    for (Worker* worker : workers) {
+        SDL_DestroyMutex(worker->mutex);
+        delete worker;
+    }
+    workers.clear();
+
+    for (QueuedJob* job : mainThreadJobs) {
+        delete job;
+    }
+    mainThreadJobs.clear();
+
+    if (statsMutex) SDL_DestroyMutex(statsMutex);
+    if (counterDone) SDL_DestroyCondition(counterDone);
+    if (doneMutex) SDL_DestroyMutex(doneMutex);
+    if (mainMutex) SDL_DestroyMutex(mainMutex);
+    if (dependencyMutex) SDL_DestroyMutex(dependencyMutex);
+    if (jobsQueued) SDL_DestroySemaphore(jobsQueued);
+}
+
+void JobSystem::run(const char* name, Work work, JobCounter* counter, JobCounter* dependsOn)
+{
+    submit(new QueuedJob{ name, move(work), counter, false }, dependsOn);
+}
+
+void JobSystem::queueOnMainThread(const char* name, Work work, JobCounter* counter, JobCounter* dependsOn)
+{
+    submit(new QueuedJob{ name, move(work), counter, true }, dependsOn);
+}
+
+void JobSystem::submit(QueuedJob* job, JobCounter* dependsOn)
+{
+    //Counters only change under dependencyMutex, so the last job to finish sees its dependents
+    SDL_LockMutex(dependencyMutex);
+    if (job->counter) {
+        job->counter->pending++;
+    }
+    if (dependsOn && !dependsOn->isDone()) {
+        dependsOn->waiting.push_back(job);
+        job = nullptr;
+    }
+    SDL_UnlockMutex(dependencyMutex);
+
+    if (job) {
+        schedule(job);
+    }
+}
+
+void JobSystem::schedule(QueuedJob* job)
+{
+    if (!job->mainThread) {
+        push(job);
+        return;
+    }
+
+    SDL_LockMutex(mainMutex);
+    bool wasEmpty = mainThreadJobs.empty();
+    mainThreadJobs.push_back(job);
+    SDL_UnlockMutex(mainMutex);
+
+    //One wake up is enough for everything queued before the next pump
+    if (wasEmpty) {
+        wakeMainThread();
+    }
+}
+
+void JobSystem::wakeMainThread()
+{
+    if (wakeEventType == 0) return;
+    SDL_Event event{ 0 };
+    event.type = wakeEventType;
+    SDL_PushEvent(&event);
+}
+
+void JobSystem::push(QueuedJob* job)
+{
+    if (workers.empty()) {
+        execute(job); //No threads, run it right here rather than never
+        return;
+    }
+
+    //Jobs started by a job stay with its worker, the rest take turns
+    Worker* worker = static_cast<Worker*>(currentWorker);
+    if (!worker || worker->system != this) {
+        worker = workers[nextWorker++ % workers.size()];
+    }
+
+    SDL_LockMutex(worker->mutex);
+    worker->jobs.push_back(job);
+    SDL_UnlockMutex(worker->mutex);
+    SDL_SignalSemaphore(jobsQueued);
+}
+
+QueuedJob* JobSystem::take(int workerIndex)
+{
+    QueuedJob* job = nullptr;
+    int count = static_cast<int>(workers.size());
+
+    //Newest first from our own deque
+    if (workerIndex >= 0) {
+        Worker* own = workers[workerIndex];
+        SDL_LockMutex(own->mutex);
+        if (!own->jobs.empty()) {
+            job = own->jobs.back();
+            own->jobs.pop_back();
+        }
+        SDL_UnlockMutex(own->mutex);
+        if (job) return job;
+    }
+
+    //Then the oldest job of whoever has one, starting with the next worker along
+    int first = workerIndex >= 0 ? workerIndex + 1 : 0;
+    for (int i = 0; i < count && !job; i++) {
+        Worker* victim = workers[(first + i) % count];
+        if (victim->index == workerIndex) continue;
+        SDL_LockMutex(victim->mutex);
+        if (!victim->jobs.empty()) {
+            job = victim->jobs.front();
+            victim->jobs.pop_front();
+        }
+        SDL_UnlockMutex(victim->mutex);
+    }
+    return job;
+}
+
+QueuedJob* JobSystem::takeMainThreadJob()
+{
+    QueuedJob* job = nullptr;
+    SDL_LockMutex(mainMutex);
+    if (!mainThreadJobs.empty()) {
+        job = mainThreadJobs.front();
+        mainThreadJobs.pop_front();
+    }
+    SDL_UnlockMutex(mainMutex);
+    return job;
+}
+
+void JobSystem::execute(QueuedJob* job)
+{
+    Uint64 start = SDL_GetTicksNS();
+    if (job->work) {
+        job->work();
+    }
+    Uint64 elapsed = SDL_GetTicksNS() - start;
+
+    SDL_LockMutex(statsMutex);
+    JobStats& jobStats = stats[job->name ? job->name : "unnamed"];
+    jobStats.count++;
+    jobStats.totalNS += elapsed;
+    jobStats.maxNS = max(jobStats.maxNS, elapsed);
+    SDL_UnlockMutex(statsMutex);
+
+    //Whoever waits on the counter may free it as soon as it reads zero, so that is the last use of it
+    vector<QueuedJob*> released;
+    bool counterFinished = false;
+    if (job->counter) {
+        SDL_LockMutex(dependencyMutex);
+        if (job->counter->pending == 1) {
+            released.swap(job->counter->waiting);
+            counterFinished = true;
+        }
+        job->counter->pending--;
+        SDL_UnlockMutex(dependencyMutex);
+    }
+    delete job;
+
+    for (QueuedJob* dependent : released) {
+        schedule(dependent);
+    }
+    if (counterFinished) {
+        SDL_LockMutex(doneMutex);
+        SDL_BroadcastCondition(counterDone);
+        SDL_UnlockMutex(doneMutex);
+    }
+}
+
+int SDLCALL JobSystem::workerMain(void* data)
+{
+    Worker* worker = static_cast<Worker*>(data);
+    JobSystem* system = worker->system;
+    currentWorker = worker;
+    while (true) {
+        if (QueuedJob* job = system->take(worker->index)) {
+            system->execute(job);
+            continue;
+        }
+        if (system->quitting) break;
+        SDL_WaitSemaphoreTimeout(system->jobsQueued, IDLE_WAIT_MS);
+    }
+    return 0;
+}
+
+void JobSystem::wait(JobCounter* counter)
+{
+    if (!counter) return;
+
+    //Main thread jobs are left alone, they would run in the middle of whatever is waiting
+    Worker* worker = static_cast<Worker*>(currentWorker);
+    int workerIndex = worker && worker->system == this ? worker->index : -1;
+    while (!counter->isDone()) {
+        QueuedJob* job = take(workerIndex);
+        if (job) {
+            execute(job);
+            continue;
+        }
+
+        //Nothing to help with, sleep until a counter finishes or more work may have turned up
+        SDL_LockMutex(doneMutex);
+        if (!counter->isDone()) {
+            SDL_WaitConditionTimeout(counterDone, doneMutex, WAIT_POLL_MS);
+        }
+        SDL_UnlockMutex(doneMutex);
+    }
+}
+
+bool JobSystem::pumpMainThread(Uint64 budgetNS)
+{
+    Uint64 start = SDL_GetTicksNS();
+    bool ranAny = false;
+    do {
+        QueuedJob* job = takeMainThreadJob();
+        if (!job) break;
+        execute(job);
+        ranAny = true;
+    } while (SDL_GetTicksNS() - start < budgetNS);
+    return ranAny;
+}
+
+unordered_map<string, JobStats> JobSystem::getStats()
+{
+    SDL_LockMutex(statsMutex);
+    unordered_map<string, JobStats> copy = stats;
+    SDL_UnlockMutex(statsMutex);
+    return copy;
+}
+
+void JobSystem::logStats()
+{
+    unordered_map<string, JobStats> current = getStats();
+    vector<pair<string, JobStats>> sorted(current.begin(), current.end());
+    sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.totalNS > b.second.totalNS; });
+
+    cout << "Jobs on " << workers.size() << " workers" << endl;
+    cout << left << setw(20) << "  job" << right << setw(8) << "count" << setw(12) << "total ms"
+         << setw(10) << "avg us" << setw(10) << "max us" << endl;
+    for (const auto& entry : sorted) {
+        const JobStats& jobStats = entry.second;
+        cout << left << setw(20) << ("  " + entry.first) << right
+             << setw(8) << jobStats.count
+             << setw(12) << fixed << setprecision(1) << jobStats.totalNS / 1e6
+             << setw(10) << jobStats.totalNS / 1e3 / jobStats.count
+             << setw(10) << jobStats.maxNS / 1e3 << endl;
+    }
+    cout.unsetf(ios::fixed);
+}
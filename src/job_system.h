@@ -0,0 +1,113 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+struct QueuedJob; // a job started on the JobSystem, internal to it
+
+// Counts the jobs started with it that haven't finished yet. Wait on it with
+// JobSystem::wait(), or pass it as another job's dependency to run that job once it is zero.
+// Must outlive the jobs counted on it and the jobs depending on it.
+class JobCounter {
+public:
+    bool isDone() const { return pending == 0; }
+
+private:
+    friend class JobSystem;
+    atomic<int> pending{ 0 };
+    vector<QueuedJob*> waiting; // jobs depending on this, guarded by JobSystem::dependencyMutex
+};
+
+// Time spent in the jobs of one name
+struct JobStats {
+    Uint64 count = 0;
+    Uint64 totalNS = 0;
+    Uint64 maxNS = 0;
+};
+
+// A pool of worker threads for CPU work: decoding, layout, loading and saving.
+// Each worker has its own deque. It takes its newest job first, since that is the one
+// most likely still in cache, and when it runs out it steals the oldest job of another
+// worker. Jobs started from outside the pool are spread over the workers in turn.
+//
+// Work that has to touch the renderer, the window or the scenes is queued with
+// queueOnMainThread() and run by the game loop in pumpMainThread(), in the order it was
+// queued. This is the game's only main thread queue, the simulation's handoffs go through
+// it too. Jobs run outside the world lock and take it only while they change the scenes,
+// so a slow load in one doesn't hold up ticks.
+class JobSystem {
+public:
+    using Work = function<void()>;
+
+    // 0 workers picks one per core left over by the main and simulation threads
+    JobSystem(int workerCount = 0);
+    // Finishes every job already started. Main thread jobs still queued are dropped.
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Runs work on a worker. counter, if given, counts it until it finishes; dependsOn, if
+    // given, holds it back until that counter is done. name groups its timings in the stats.
+    void run(const char* name, Work work, JobCounter* counter = nullptr, JobCounter* dependsOn = nullptr);
+    // The same, but runs on the main thread
+    void queueOnMainThread(const char* name, Work work, JobCounter* counter = nullptr, JobCounter* dependsOn = nullptr);
+
+    // Runs other worker jobs while waiting for counter to be done, so waiting never idles a
+    // thread. Main thread jobs only run in pumpMainThread(), so never wait on one.
+    void wait(JobCounter* counter);
+
+    // Call on the main thread once per frame, outside the world lock. Runs queued main
+    // thread jobs until budgetNS has passed and returns true if it ran anything.
+    bool pumpMainThread(Uint64 budgetNS);
+    // Ends the main thread's wait for events, so it pumps and draws. Safe from any thread.
+    void wakeMainThread();
+    // The event wakeMainThread() pushes, the main loop should ignore it
+    Uint32 getWakeEventType() const { return wakeEventType; }
+
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+    unordered_map<string, JobStats> getStats();
+    void logStats();
+
+private:
+    struct Worker {
+        JobSystem* system = nullptr;
+        int index = 0;
+        SDL_Thread* thread = nullptr;
+        SDL_Mutex* mutex = nullptr;
+        deque<QueuedJob*> jobs; // guarded by mutex, the owner pops from the back, thieves from the front
+    };
+
+    static int SDLCALL workerMain(void* data);
+    void submit(QueuedJob* job, JobCounter* dependsOn);
+    void schedule(QueuedJob* job);
+    void push(QueuedJob* job);
+    QueuedJob* take(int workerIndex);
+    QueuedJob* takeMainThreadJob();
+    void execute(QueuedJob* job);
+
+    static const int MAX_WORKERS = 8;
+    static const Sint32 IDLE_WAIT_MS = 100; // how often idle workers check whether to quit
+
+    vector<Worker*> workers;
+    atomic<unsigned> nextWorker{ 0 };
+    SDL_Semaphore* jobsQueued = nullptr; // signalled once per job pushed to a worker
+    atomic<bool> quitting{ false };
+
+    SDL_Mutex* dependencyMutex = nullptr;
+    SDL_Mutex* mainMutex = nullptr;
+    deque<QueuedJob*> mainThreadJobs; // guarded by mainMutex
+    Uint32 wakeEventType = 0;
+
+    SDL_Mutex* doneMutex = nullptr;
+    SDL_Condition* counterDone = nullptr; // broadcast whenever a counter reaches zero
+
+    SDL_Mutex* statsMutex = nullptr;
+    unordered_map<string, JobStats> stats; // guarded by statsMutex
+};
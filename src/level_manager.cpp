@@ -1,6 +1,5 @@
 #include <vector>
 #include <memory>
-#include <sstream>
 #include <cstdint>
 #include "level_manager.h"
 #include "minigames/minigame.h"
@@ -9,6 +8,15 @@
 #include "minigames/frying_game.h"
 #include "minigames/egg_cracking_game.h"
 #include "data_structs.h"
+#include "text_renderer.h"
+#include "asset_ids.h"
+#include "text_layout.h"
+#include "font_manager.h"
+#include "string_table.h"
+#include "clock.h"
+#include "frame_pacer.h"
+#include "power_policy.h"
+#include "simulation.h"
 #include <iostream>
 
 using namespace std;
@@ -17,10 +25,24 @@ using namespace std;
 LevelManager::LevelManager(SDLState& state)
     : state(state), currentMinigame(nullptr), recipeStarted(false),
     recipeFinished(false), playStartAnimation(false), playFinishAnimation(false),
-    selectButton(300, 320, 200, 100, "Select", "", [this]() { onSelectClick(); }),
+    selectButton(300, 320, 200, 100, "Select", "", [this]() { changeStep("select recipe", [this]() { onSelectClick(); }); }),
     rightButton(10, 100, 60, 60, "Settings", "", [this]() { lClick(); }),
     leftButton(10, 10, 60, 60, "Settings", "", [this]() { rClick(); })
 {
+    // "Start!"/"Finished!" are drawn at 4x the normal font size, laid out once from a font that
+    // size so they stay crisp instead of stretching the normal font
+    if (state.fonts && state.font) {
+        overlayFont = state.fonts->getSizedFont(state.font, TTF_GetFontSize(state.font) * 4.0f);
+    }
+    overlayCaptionScale = overlayFont ? 1.0f : 4.0f;
+    if (!overlayFont) {
+        overlayFont = state.font;
+    }
+    if (state.strings) {
+        state.strings->prepare(StringId::Start, overlayFont);
+        state.strings->prepare(StringId::Finished, overlayFont);
+    }
+
     //Load all available recipes
     loadTextures();
     configureLayout();
@@ -28,9 +50,9 @@ LevelManager::LevelManager(SDLState& state)
 }
 void LevelManager::loadTextures() {
     // Load button textures
-    rightTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/hand_r.PNG");
-    leftTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/hand_l.PNG");
-    selectTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/select.PNG");
+    rightTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::HAND_R]);
+    leftTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::HAND_L]);
+    selectTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::SELECT]);
 
     // Set loaded textures to image buttons
     leftButton.setTexture(leftTexture);
@@ -38,36 +60,25 @@ void LevelManager::loadTextures() {
     selectButton.setTexture(selectTexture);
     
     // Load card illustration textures
-    ill_cooking = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/cooking_i.PNG");
-    ill_cracking = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/cracking_i.PNG");
-    ill_mixing = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/mixing_i.PNG");
-    ill_cutting = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/cutting_i.PNG");
-    ill_infinity_cracking = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/endless_i.PNG");
-    ill_multiple = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/multiple_i.PNG");
+    ill_cooking = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::COOKING_I]);
+    ill_cracking = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::CRACKING_I]);
+    ill_mixing = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::MIXING_I]);
+    ill_cutting = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::CUTTING_I]);
+    ill_infinity_cracking = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::ENDLESS_I]);
+    ill_multiple = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::MULTIPLE_I]);
 }
 
 void LevelManager::cleanupTextures() {
-    if (rightTexture) SDL_DestroyTexture(rightTexture);
-    if (leftTexture) SDL_DestroyTexture(leftTexture);
-    if (selectTexture) SDL_DestroyTexture(selectTexture);
-
-    leftTexture = nullptr;
-    rightTexture = nullptr;
-    selectTexture = nullptr;
-    
-    if (ill_cooking) SDL_DestroyTexture(ill_cooking);
-    if (ill_cracking) SDL_DestroyTexture(ill_cracking);
-    if (ill_mixing) SDL_DestroyTexture(ill_mixing);
-    if (ill_cutting) SDL_DestroyTexture(ill_cutting);
-    if (ill_infinity_cracking) SDL_DestroyTexture(ill_infinity_cracking);
-    if (ill_multiple) SDL_DestroyTexture(ill_multiple);
-    
-    ill_cooking = nullptr;
-    ill_cracking = nullptr;
-    ill_mixing = nullptr;
-    ill_cutting = nullptr;
-    ill_infinity_cracking = nullptr;
-    ill_multiple = nullptr;
+    leftTexture.reset();
+    rightTexture.reset();
+    selectTexture.reset();
+
+    ill_cooking.reset();
+    ill_cracking.reset();
+    ill_mixing.reset();
+    ill_cutting.reset();
+    ill_infinity_cracking.reset();
+    ill_multiple.reset();
 }
 
 
@@ -75,39 +86,26 @@ void LevelManager::configureLayout() {
     // No further layout changes are needed since buttons are already configured in their constructors
 }
 
-void LevelManager::render() {
+void LevelManager::render(float alpha) {
+    if (isAnimating()) {
+        state.pacer->markDirty();
+    }
+
     if (recipeStarted && currentMinigame != nullptr) {
-        currentMinigame->render();
+        //The minigame isn't updated during animations and results, so it has nothing to blend towards
+        bool paused = playStartAnimation || playFinishAnimation || showingResults || currentMinigame->isComplete();
+        currentMinigame->render(paused ? 1.0f : alpha);
 
         if (showingResults) {
             renderResults();
         }
 
         if ((playStartAnimation || playFinishAnimation) && !showingResults) {
-            string text = playStartAnimation ? "Start!" : "Finished!";
+            StringId caption = playStartAnimation ? StringId::Start : StringId::Finished;
             SDL_Color textColor = { 255, 255, 255, SDL_ALPHA_OPAQUE };
 
-            SDL_Surface* textSurface = TTF_RenderText_Solid(state.font, text.c_str(), 0, textColor);
-            if (textSurface) {
-                SDL_Texture* textTexture = SDL_CreateTextureFromSurface(state.renderer, textSurface);
-                if (textTexture) {
-                    float textW, textH;
-                    SDL_GetTextureSize(textTexture, &textW, &textH);
-                    textW = textW * 4.0f;
-                    textH = textH * 4.0f;
-                    // Center the text on screen
-                    SDL_FRect textRect = {
-                        (state.logW - textW) / 2.0f,
-                        (state.logH - textH) / 2.0f,
-                        textW,
-                        textH
-                    };
-
-                    SDL_RenderTexture(state.renderer, textTexture, nullptr, &textRect);
-                    SDL_DestroyTexture(textTexture);
-                }
-                SDL_DestroySurface(textSurface);
-            }
+            // Center the text on screen
+            state.strings->draw(caption, overlayFont, state.logW / 2.0f, state.logH / 2.0f, textColor, 0.5f, 0.5f, overlayCaptionScale);
         }
     }
     else { //Render the level select screen
@@ -118,11 +116,12 @@ void LevelManager::render() {
         //Find center of screen
         float centerX = (float)state.logW / 2;
         float centerY = (float)state.logH / 2;
+        float scrollPosition = interpolate(prevScrollPosition, currentScrollPosition, alpha);
 
         // Render each recipe card
         for (size_t i = 0; i < recipes.size(); i++) {
             // Calculate position using smooth scroll position
-            float cardOffset = i * (CARD_WIDTH + CARD_SPACING) - currentScrollPosition;
+            float cardOffset = i * (CARD_WIDTH + CARD_SPACING) - scrollPosition;
             float xPos = centerX + cardOffset;
 
             // Only render cards that are visible
@@ -154,91 +153,34 @@ void LevelManager::render() {
             SDL_RenderFillRect(state.renderer, &cardRect);
 
             //Render text with wrapping
-            string text = recipes[i].name;
-            SDL_Color textColor = { 0, 0, 0, SDL_ALPHA_OPAQUE };
-            
             // Use smaller font for non-selected cards
             TTF_Font* fontToUse = (i == selectedRecipeIndex) ? state.font : state.fontSmall;
-            
-            // Calculate max text width (90% of card width to leave padding)
-            float maxTextWidth = scaledWidth * 0.9f;
-            
-            // Split text into multiple lines if it exceeds max width
-            vector<string> textLines;
-            string currentLine;
-            stringstream ss(text);
-            string word;
-            
-            while (ss >> word) {
-                string testLine = currentLine.empty() ? word : currentLine + " " + word;
-                SDL_Surface* testSurface = TTF_RenderText_Blended(fontToUse, testLine.c_str(), 0, textColor);
-                if (testSurface) {
-                    float testWidth = (float)testSurface->w;
-                    SDL_DestroySurface(testSurface);
-                    
-                    if (testWidth > maxTextWidth && !currentLine.empty()) {
-                        // Line is too long, save current line and start new one
-                        textLines.push_back(currentLine);
-                        currentLine = word;
-                    } else {
-                        // Add word to current line
-                        currentLine = testLine;
-                    }
-                }
-            }
-            if (!currentLine.empty()) {
-                textLines.push_back(currentLine);
-            }
-            
+            const CardText& cardText = getCardText(i, fontToUse, scale);
+
             // Render each line
-            float lineHeight = 0;
             float currentY = (centerY - scaledHeight / 2) + 30.0f;
-            
-            for (size_t lineIdx = 0; lineIdx < textLines.size(); lineIdx++) {
-                SDL_Surface* textSurface = TTF_RenderText_Blended(fontToUse, textLines[lineIdx].c_str(), 0, textColor);
-                if (textSurface) {
-                    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(state.renderer, textSurface);
-
-                    if (textTexture) {
-                        float textW, textH;
-                        SDL_GetTextureSize(textTexture, &textW, &textH);
-                        
-                        if (lineIdx == 0) {
-                            lineHeight = textH;
-                        }
-
-                        SDL_FRect textRect = {
-                            (xPos - textW/2),
-                            currentY,
-                            textW,
-                            textH
-                        };
-
-                        SDL_RenderTexture(state.renderer, textTexture, nullptr, &textRect);
-                        SDL_DestroyTexture(textTexture);
-                    }
-                    SDL_DestroySurface(textSurface);
-                    currentY += lineHeight + 2.0f; // Add spacing between lines
-                }
+            for (const auto& line : cardText.lines) {
+                line->render(xPos, currentY, 0.5f, 0.0f);
+                currentY += cardText.lineHeight + 2.0f; // Add spacing between lines
             }
             
             // Render card illustration in the center
-            SDL_Texture* cardIllTexture = nullptr;
+            const TextureHandle* cardIllTexture = nullptr;
             string recipeName = recipes[i].name;
             
             // Determine which texture to use based on recipe name
             if (recipeName.find("Multiple") != string::npos) {
-                cardIllTexture = ill_multiple;
+                cardIllTexture = &ill_multiple;
             } else if (recipeName.find("Endless") != string::npos) {
-                cardIllTexture = ill_infinity_cracking;
+                cardIllTexture = &ill_infinity_cracking;
             } else if (recipeName.find("Frying") != string::npos) {
-                cardIllTexture = ill_cooking;
+                cardIllTexture = &ill_cooking;
             } else if (recipeName.find("Mixing") != string::npos) {
-                cardIllTexture = ill_mixing;
+                cardIllTexture = &ill_mixing;
             } else if (recipeName.find("Cutting") != string::npos) {
-                cardIllTexture = ill_cutting;
+                cardIllTexture = &ill_cutting;
             } else if (recipeName.find("Cracking") != string::npos) {
-                cardIllTexture = ill_cracking;
+                cardIllTexture = &ill_cracking;
             }
             
             // Render the illustrations!!!
@@ -254,14 +196,14 @@ void LevelManager::render() {
                     illHeight
                 };
                 
-                SDL_RenderTexture(state.renderer, cardIllTexture, nullptr, &illRect);
+                cardIllTexture->render(state.renderer, nullptr, &illRect);
             }
         }//End of card render loop
 
         //Render select button if not switching cards
         if (!isCarouselAnimating()) {
             // Update button fade-in alpha
-            uint64_t elapsedMs = SDL_GetTicks() - buttonFadeStartTick;
+            uint64_t elapsedMs = state.clock->nowMS() - buttonFadeStartTick;
             if (elapsedMs < BUTTON_FADE_DURATION_MS) {
                 buttonFade = static_cast<float>(elapsedMs) / static_cast<float>(BUTTON_FADE_DURATION_MS);
             } else {
@@ -270,21 +212,54 @@ void LevelManager::render() {
             
             // Set button opacity for rendering
             uint8_t opacity = (uint8_t)(buttonFade * 255);
-            SDL_SetTextureAlphaMod(selectTexture, opacity);
+            selectTexture.setAlphaMod(opacity);
             selectButton.render(state);
-            SDL_SetTextureAlphaMod(selectTexture, 255);  // Reset to full opacity
+            selectTexture.setAlphaMod(255);  // Reset to full opacity
+        }
+    }
+}
+
+// Returns the wrapped name for a card, laying it out only the first time this
+// (recipe, font, width bucket) combination is seen
+const LevelManager::CardText& LevelManager::getCardText(size_t recipeIndex, TTF_Font* font, float scale)
+{
+    int widthBucket = static_cast<int>(scale * CARD_SCALE_BUCKETS);
+    auto key = make_tuple(recipeIndex, font, widthBucket);
+
+    auto it = cardTextCache.find(key);
+    if (it != cardTextCache.end()) {
+        return it->second;
+    }
+
+    // Calculate max text width (90% of card width to leave padding)
+    float bucketScale = static_cast<float>(widthBucket) / CARD_SCALE_BUCKETS;
+    float maxTextWidth = CARD_WIDTH * bucketScale * 0.9f;
+
+    CardText& cardText = cardTextCache[key];
+    SDL_Color textColor = { 0, 0, 0, SDL_ALPHA_OPAQUE };
+    for (const auto& line : TextLayout::wrapWords(font, recipes[recipeIndex].name, maxTextWidth)) {
+        auto label = make_unique<TextLabel>();
+        label->setText(state.text, font, line.text.c_str(), textColor);
+        if (cardText.lines.empty()) {
+            cardText.lineHeight = label->getSize().y;
         }
+        cardText.lines.push_back(move(label));
     }
+    return cardText;
 }
 
-void LevelManager::update() {
+bool LevelManager::update() {
+    //The main thread is swapping minigames, hold still until the swap is drawn
+    if (stepChangePending) return false;
+    bool wasAnimating = isAnimating(); //The tick that stops an animation moves it one last time
+
     // Reset button fade when carousel animation stops
     if (!isCarouselAnimating() && buttonFadeStartTick == 0) {
-        buttonFadeStartTick = SDL_GetTicks();
+        buttonFadeStartTick = state.clock->nowMS();
     }
     if (recipeStarted && currentMinigame != nullptr) {
         if (showingResults) {
-            uint64_t elapsed = SDL_GetTicks() - resultsStartTick;
+            uint64_t elapsed = state.clock->nowMS() - resultsStartTick;
             if (elapsed >= RESULTS_DURATION_MS) {
                 showingResults = false;
                 playFinishAnimation = true;
@@ -292,6 +267,10 @@ void LevelManager::update() {
             }
         }
         else if (playStartAnimation || playFinishAnimation) {
+            //Build the next step a frame after the handoff, so the two don't land on the same frame
+            if (prefetchPending && onMainThread("prefetch step", [this]() { prefetchNextStep(); })) {
+                prefetchPending = false; //Queued once, not every tick until it runs
+            }
             animationTickCounter++;
 
             // Check if 2 seconds have elapsed
@@ -300,8 +279,7 @@ void LevelManager::update() {
                     playStartAnimation = false;
                 }
                 else {
-                    playFinishAnimation = false;
-                    advanceStep();
+                    changeStep("next step", [this]() { advanceStep(); });
                 }
                 animationTickCounter = 0; // Reset counter
             }
@@ -314,15 +292,20 @@ void LevelManager::update() {
         }
     }
     else {  //update the level select screen
+        prevScrollPosition = currentScrollPosition;
+
         // Interpolate current position toward target
+        //Fewer frames of animation on battery
+        float speed = SDL_min(1.0f, SCROLL_SPEED * state.power->getProfile().carouselSpeedup);
         float distance = targetScrollPosition - currentScrollPosition;
-        currentScrollPosition += distance * SCROLL_SPEED;
+        currentScrollPosition += distance * speed;
 
         // Snap to target when very close (prevents infinite tiny movements)
         if (abs(distance) < 0.5f) {
             currentScrollPosition = targetScrollPosition;
         }
     }
+    return wasAnimating || isAnimating();
 }
 
 void LevelManager::handleEvent(const SDL_Event& event) {
@@ -383,7 +366,7 @@ void LevelManager::startResultsDisplay(const std::vector<int>& scores)
 {
     resultScores = scores;
     showingResults = true;
-    resultsStartTick = SDL_GetTicks();
+    resultsStartTick = state.clock->nowMS();
     animationTickCounter = 0;
 }
 
@@ -415,29 +398,11 @@ void LevelManager::renderResults()
         SDL_SetRenderDrawColor(state.renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
         SDL_RenderRect(state.renderer, &rect);
 
-        if (state.font) {
+        if (state.font && state.text) {
             string scoreText = to_string(resultScores[0]);
             SDL_Color textColor = { 255, 255, 255, SDL_ALPHA_OPAQUE };
-            SDL_Surface* textSurface = TTF_RenderText_Solid(state.font, scoreText.c_str(), 0, textColor);
-
-            if (textSurface) {
-                SDL_Texture* textTexture = SDL_CreateTextureFromSurface(state.renderer, textSurface);
-                if (textTexture) {
-                    float textW, textH;
-                    SDL_GetTextureSize(textTexture, &textW, &textH);
-
-                    SDL_FRect textRect = {
-                        rect.x + (rect.w - textW) / 2.0f,
-                        rect.y + (rect.h - textH) / 2.0f,
-                        textW,
-                        textH
-                    };
-
-                    SDL_RenderTexture(state.renderer, textTexture, nullptr, &textRect);
-                    SDL_DestroyTexture(textTexture);
-                }
-                SDL_DestroySurface(textSurface);
-            }
+            scoreLabel.setText(state.text, state.font, scoreText.c_str(), textColor);
+            scoreLabel.render(rect.x + rect.w / 2.0f, rect.y + rect.h / 2.0f, 0.5f, 0.5f);
         }
     }
 
@@ -454,40 +419,129 @@ void LevelManager::resetToLevelSelect()
     resultsStartTick = 0;
     resultScores.clear();
     currentMinigame.reset();
+    nextMinigame.reset();
+    prefetchPending = false;
+    prevScrollPosition = currentScrollPosition;
 
     if (currentRecipe) {
         currentRecipe->currentStep = 0;
     }
 }
 
+unique_ptr<Minigame> LevelManager::createMinigame(const CookingStep& step)
+{
+    if (step.action == "cut") {
+        return make_unique<CuttingGame>(state, step);
+    }
+    else if (step.action == "mix") {
+        return make_unique<MixingGame>(state, step);
+    }
+    else if (step.action == "fry") {
+        return make_unique<FryingGame>(state, step);
+    }
+    else if (step.action == "egg") {
+        return make_unique<EggCrackingGame>(state, step, EggCrackingGame::Mode::Normal);
+    }
+    else if (step.action == "egg_endless") {
+        return make_unique<EggCrackingGame>(state, step, EggCrackingGame::Mode::Endless);
+    }
+    return nullptr;
+}
+
+//Minigames load textures and grab the mouse when they're built, started and destroyed,
+//which SDL only allows on the main thread, while update and input run on the simulation thread.
+//work runs before the next frame is drawn, outside the world lock; returns false if it never will.
+//It takes the lock itself, only for the state the simulation thread sees.
+bool LevelManager::onMainThread(const char* name, function<void()> work)
+{
+    if (state.simulation) {
+        return state.simulation->queueOnMainThread(name, move(work));
+    }
+    work();
+    return true;
+}
+
+//Swaps minigames on the main thread. The recipe holds still until the swap ran,
+//and nothing changes if it can't run.
+void LevelManager::changeStep(const char* name, function<void()> change)
+{
+    if (stepChangePending) return;
+    stepChangePending = true;
+    bool queued = onMainThread(name, [this, change]() {
+        change();
+        lockWorld();
+        stepChangePending = false;
+        unlockWorld();
+    });
+    if (!queued) {
+        stepChangePending = false;
+    }
+}
+
+//Constructs the step after the current one so its textures load while this one is played.
+//Only the main thread moves the recipe along or touches nextMinigame, so no lock is needed.
+void LevelManager::prefetchNextStep()
+{
+    if (!currentRecipe || nextMinigame || currentRecipe->currentStep < 0) return;
+    size_t step = static_cast<size_t>(currentRecipe->currentStep);
+    if (step >= currentRecipe->steps.size()) return;
+
+    nextMinigame = createMinigame(currentRecipe->steps[step]);
+}
+
+//Main thread only. Builds the next minigame outside the world lock, so loading its textures
+//doesn't hold up ticks, and locks only to swap it in.
 void LevelManager::advanceStep()
 {
-    if (currentRecipe->currentStep <= currentRecipe->steps.size() - 1) {
-        string action = currentRecipe->steps[currentRecipe->currentStep].action;
-        if (action == "cut") {
-            currentMinigame = make_unique<CuttingGame>(state, (*currentRecipe).steps[0]);
-        }
-        else if (action == "mix") { 
-            currentMinigame = make_unique<MixingGame>(state, (*currentRecipe).steps[0]);
-        }
-        else if (action == "fry") {
-            currentMinigame = make_unique<FryingGame>(state, (*currentRecipe).steps[0]);
-        }
-        else if (action == "egg") {
-            currentMinigame = make_unique<EggCrackingGame>(state, (*currentRecipe).steps[0], EggCrackingGame::Mode::Normal);
-        }
-        else if (action == "egg_endless") {
-            currentMinigame = make_unique<EggCrackingGame>(state, (*currentRecipe).steps[0], EggCrackingGame::Mode::Endless);
+    //Only the main thread moves the recipe along, so it can read where it is without the lock
+    bool hasStep = currentRecipe && currentRecipe->currentStep >= 0
+        && static_cast<size_t>(currentRecipe->currentStep) < currentRecipe->steps.size();
+    unique_ptr<Minigame> minigame;
+    if (hasStep) {
+        const CookingStep& step = currentRecipe->steps[currentRecipe->currentStep];
+        Uint64 transitionStart = SDL_GetTicksNS();
+        bool prefetched = nextMinigame != nullptr;
+
+        minigame = prefetched ? move(nextMinigame) : createMinigame(step);
+        if (minigame) {
+            minigame->begin();
         }
 
+        cout << "Step " << currentRecipe->currentStep + 1 << " transition took "
+             << (SDL_GetTicksNS() - transitionStart) / 1000 << " us ("
+             << (prefetched ? "prefetched" : "built on demand") << ")" << endl;
+        state.textures->logStats();
+    }
+
+    //The finish caption goes with the swap, so no frame draws the old minigame without it
+    lockWorld();
+    swap(currentMinigame, minigame);
+    playFinishAnimation = false;
+    if (hasStep) {
         currentRecipe->currentStep++;
         recipeStarted = true;
         playStartAnimation = true;
+        prefetchPending = true;
     }
     else { //No more cooking steps means recipe is complete
         recipeFinished = true;
         resetToLevelSelect();
     }
+    unlockWorld();
+
+    //The old minigame is only destroyed after the new one acquired its textures,
+    //so anything they share is never reloaded
+    minigame.reset();
+}
+
+void LevelManager::lockWorld()
+{
+    if (state.simulation) state.simulation->lock();
+}
+
+void LevelManager::unlockWorld()
+{
+    if (state.simulation) state.simulation->unlock();
 }
 
 void LevelManager::loadRecipes() {
@@ -600,11 +654,13 @@ void LevelManager::loadRecipes() {
 
 void LevelManager::onSelectClick()
 {
+    lockWorld();
     cout << "Select Button Clicked! Recipe Index: " << selectedRecipeIndex << endl;
     recipeFinished = false;
     resetToLevelSelect();
     currentRecipe = &recipes[selectedRecipeIndex];
     currentRecipe->currentStep = 0;
+    unlockWorld();
     advanceStep();
 }
 
@@ -627,6 +683,12 @@ void LevelManager::rClick()
 }
 
 
+//Minigames, the carousel and the button fade move on their own, so keep drawing while they run
+bool LevelManager::isAnimating() const
+{
+    return recipeStarted || isCarouselAnimating() || buttonFade < 1.0f;
+}
+
 bool LevelManager::isCarouselAnimating() const
 {
     const float THRESHOLD = 0.5f;
@@ -2,9 +2,14 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
+#include <map>
+#include <tuple>
 #include "data_structs.h"
 #include "button.h"
 #include "image_button.h"
+#include "texture_cache.h"
+#include "text_label.h"
 #include "minigames/minigame.h"
 #include "minigames/cutting_game.h"
 #include "minigames/egg_cracking_game.h"
@@ -18,9 +23,10 @@ public:
     void advanceStep();
     bool isRecipeComplete();
 
-    void render();
-    void update();
+    void render(float alpha);
+    bool update(); // returns true if what's on screen changed
     void handleEvent(const SDL_Event& event);
+    bool isPlaying() const { return recipeStarted; } // in a minigame rather than on level select
 
 private:
     void renderResults();
@@ -29,15 +35,27 @@ private:
     void lClick();
     void rClick();
     void configureLayout();
+    bool isAnimating() const;
     bool isCarouselAnimating() const;
     void resetToLevelSelect();
+    unique_ptr<Minigame> createMinigame(const CookingStep& step);
+    bool onMainThread(const char* name, function<void()> work);
+    void changeStep(const char* name, function<void()> change);
+    void lockWorld();
+    void unlockWorld();
+    void prefetchNextStep();
 
     unique_ptr<Minigame> currentMinigame;
+    unique_ptr<Minigame> nextMinigame; // built while the current step plays, swapped in by advanceStep
+    bool prefetchPending = false;
+    bool stepChangePending = false; // a minigame swap is queued for the main thread
     SDLState& state;
     std::vector<Recipe> recipes;
     Recipe* currentRecipe = nullptr;
     bool recipeStarted, recipeFinished, playStartAnimation, playFinishAnimation;
     int animationTickCounter = 0;
+    TTF_Font* overlayFont = nullptr; // owned by state.fonts
+    float overlayCaptionScale = 1.0f;
     const int ANIMATION_DURATION_TICKS = 100; // 2 seconds at 50 updates/second
 
     //Variables for level select screen
@@ -45,16 +63,16 @@ private:
 	ImageButton leftButton;
 	ImageButton rightButton;
 
-    SDL_Texture* leftTexture = nullptr;
-    SDL_Texture* rightTexture = nullptr;
-    SDL_Texture* selectTexture = nullptr;
+    TextureHandle leftTexture;
+    TextureHandle rightTexture;
+    TextureHandle selectTexture;
 
-    SDL_Texture* ill_cooking = nullptr;
-    SDL_Texture* ill_cracking = nullptr;
-    SDL_Texture* ill_mixing = nullptr;
-    SDL_Texture* ill_cutting = nullptr;
-    SDL_Texture* ill_infinity_cracking = nullptr;
-    SDL_Texture* ill_multiple = nullptr;
+    TextureHandle ill_cooking;
+    TextureHandle ill_cracking;
+    TextureHandle ill_mixing;
+    TextureHandle ill_cutting;
+    TextureHandle ill_infinity_cracking;
+    TextureHandle ill_multiple;
 
     // Layout / assets
     void loadTextures();
@@ -62,10 +80,20 @@ private:
 
     int selectedRecipeIndex = 0;
     float currentScrollPosition = 0.0f;  // Current visual position
+    float prevScrollPosition = 0.0f;     // Position before the last update, for render interpolation
     float targetScrollPosition = 0.0f;   // Where we're scrolling to
     const float SCROLL_SPEED = 0.15f;    // Interpolation speed (0.0-1.0)
     const float CARD_WIDTH = 300.0f;
     const float CARD_SPACING = 50.0f;
+
+    // Wrapped recipe names, laid out once per (recipe, font, width bucket)
+    struct CardText {
+        vector<unique_ptr<TextLabel>> lines;
+        float lineHeight = 0.0f;
+    };
+    const float CARD_SCALE_BUCKETS = 20.0f; // card scale is quantized to steps of 0.05
+    map<tuple<size_t, TTF_Font*, int>, CardText> cardTextCache;
+    const CardText& getCardText(size_t recipeIndex, TTF_Font* font, float scale);
     
     // Fade-in animation for select button attempt
     uint64_t buttonFadeStartTick = 0;
@@ -77,4 +105,5 @@ private:
     uint64_t resultsStartTick = 0;
     const uint64_t RESULTS_DURATION_MS = 3000;
     std::vector<int> resultScores;
+    TextLabel scoreLabel; //Only re-laid out when the score shown changes
 };
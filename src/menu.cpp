@@ -2,6 +2,8 @@
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_image/SDL_image.h>
+#include "texture_cache.h"
+#include "asset_ids.h"
 #include <iostream>
 
 using namespace std;
@@ -46,12 +48,12 @@ Menu::~Menu() {
 }
 
 void Menu::loadTextures() {
-    backgroundTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/menu_bg.PNG");
+    backgroundTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::MENU_BG]);
 
     // Load button textures
-    startTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/start_btn.PNG");
-    settingTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/setting_btn.PNG");
-    exitTexture = IMG_LoadTexture(state.renderer, "src/res/sprites/menu_graph/exit.PNG");
+    startTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::START_BTN]);
+    settingTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::SETTING_BTN]);
+    exitTexture = state.textures->acquireAsync(Sprites::MenuGraph::PATHS[Sprites::MenuGraph::EXIT]);
 
     // Set loaded textures
     startButton.setTexture(startTexture);
@@ -63,15 +65,11 @@ void Menu::loadTextures() {
 }
 
 void Menu::cleanupTextures() {
-    if (backgroundTexture) SDL_DestroyTexture(backgroundTexture);
-    if (startTexture) SDL_DestroyTexture(startTexture);
-    if (settingTexture) SDL_DestroyTexture(settingTexture);
-    if (exitTexture) SDL_DestroyTexture(exitTexture);
-
-    backgroundTexture = nullptr;
-    startTexture = nullptr;
-    settingTexture = nullptr;
-    exitTexture = nullptr;
+    // Handing the textures back lets the cache decide when to free them
+    backgroundTexture.reset();
+    startTexture.reset();
+    settingTexture.reset();
+    exitTexture.reset();
 }
 
 void Menu::configureLayout() {
@@ -84,7 +82,7 @@ void Menu::render() {
 
     // Render bg
     if (backgroundTexture) {
-        SDL_RenderTexture(renderer, backgroundTexture, nullptr, nullptr);
+        backgroundTexture.render(renderer, nullptr, nullptr);
     }
     else {
         SDL_FRect bg{ 0.0f, 0.0f, static_cast<float>(state.logW), static_cast<float>(state.logH) };
@@ -6,6 +6,7 @@
 #include "button.h"
 #include "image_button.h"
 #include "data_structs.h"
+#include "texture_cache.h"
 
 using namespace std;
 
@@ -24,10 +25,10 @@ private:
     ImageButton exitButton;
 
     // Textures
-    SDL_Texture* backgroundTexture = nullptr;
-    SDL_Texture* startTexture = nullptr;
-    SDL_Texture* settingTexture = nullptr;
-    SDL_Texture* exitTexture = nullptr;
+    TextureHandle backgroundTexture;
+    TextureHandle startTexture;
+    TextureHandle settingTexture;
+    TextureHandle exitTexture;
 
     // Layout / assets
     void configureLayout();
@@ -7,13 +7,16 @@
 #include "cutting_game.h"
 #include "minigame.h"
 #include "../data_structs.h"
+#include "../string_table.h"
+#include "../clock.h"
+#include "../cursor.h"
 
 using namespace std;
 
 //Cutting Minigame Implementation
 CuttingGame::CuttingGame(SDLState& state, CookingStep step)
     : state(state), step(step), isClicked(false),
-    onCooldown(false), clickTime(SDL_GetTicks()), cutsMade(0)
+    onCooldown(false), clickTime(state.clock->nowNS()), clickX(0.0f), cutsMade(0)
 {
     ingr = step.ingredients[0]; //Maybe update this to check if the array is empty later im too lazy
 
@@ -24,7 +27,7 @@ CuttingGame::CuttingGame(SDLState& state, CookingStep step)
     progressBarBG = { .x = 95, .y = 345, .w = 610, .h = 35 };
     Rectangles initRect{
         .destRect = {.x = 200, .y = 165, .w = 400, .h = 200 },
-        .sourceRect = {.x = 0, .y = 0, .w = static_cast<float>(textures[ingr.name]->w), .h = static_cast<float>(textures[ingr.name]->h)}
+        .sourceRect = {.x = 0, .y = 0, .w = ingrTexture.getWidth(), .h = ingrTexture.getHeight()}
     };
     ingrRects.push_back(initRect);
 }
@@ -34,19 +37,27 @@ CuttingGame::~CuttingGame()
     cleanup();
 }
 
-void CuttingGame::render() {
+void CuttingGame::begin() {
+    SDL_HideCursor(); //The knife line takes its place
+}
+
+void CuttingGame::render(float /*alpha*/) { //Nothing moves between updates, the knife follows the mouse itself
     SDL_Renderer* renderer = state.renderer;
 
     //Render background
-    SDL_RenderTexture(renderer, textures["background"], nullptr, nullptr);
+    textures[Sprites::CuttingGame::BG].render(renderer, nullptr, nullptr);
 
     //Render each cutup section of the ingredient
     for (const Rectangles& rects : ingrRects) {
-        SDL_RenderTexture(renderer, textures[ingr.name], &rects.sourceRect, &rects.destRect);
+        ingrTexture.render(renderer, &rects.sourceRect, &rects.destRect);
     }
 
-    //Render the dotted line for the knife
-    SDL_RenderTexture(renderer, textures["knife"], nullptr, &knifeRect); //knife is the dotted line
+    //Render the dotted line for the knife, where the mouse is now rather than at the last motion event.
+    //It stays at a fixed height, which a hardware cursor can't, so it is still drawn here.
+    SDL_FRect knife = knifeRect;
+    getLatestMousePosition(renderer, &knife.x, nullptr);
+    knife.x -= knifeRect.w / 2;
+    textures[Sprites::CuttingGame::DOTTED].render(renderer, nullptr, &knife); //knife is the dotted line
 
     //render the progress bar
     SDL_RenderFillRect(renderer, &progressBarBG);
@@ -54,42 +65,21 @@ void CuttingGame::render() {
     SDL_RenderFillRect(renderer, &progressBar);
 
     //Render text
-    string text = "Cuts Remaining: " + to_string((int)(step.duration - cutsMade));
+    char text[64];
+    SDL_snprintf(text, sizeof(text), state.strings->get(StringId::CutsRemainingFmt), (int)(step.duration - cutsMade));
     SDL_Color textColor = { 0, 0, 0, SDL_ALPHA_OPAQUE };
-    SDL_Surface* textSurface = TTF_RenderText_Solid(state.font, text.c_str(), 0, textColor);
-    if (textSurface) {
-        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-        if (textTexture) {
-            float textW, textH;
-            SDL_GetTextureSize(textTexture, &textW, &textH);
-
-            SDL_FRect textRect = {
-                progressBarBG.x + (progressBarBG.w - textW)/2,
-                progressBarBG.y + 3,
-                textW,
-                textH
-            };
-
-            SDL_RenderTexture(renderer, textTexture, nullptr, &textRect);
-            SDL_DestroyTexture(textTexture);
-        }
-        SDL_DestroySurface(textSurface);
-    }
+    cutsLabel.setText(state.text, state.font, text, textColor);
+    cutsLabel.render(progressBarBG.x + progressBarBG.w / 2, progressBarBG.y + 3, 0.5f, 0.0f);
 }
 
 void CuttingGame::update() {
-    SDL_HideCursor();
-
-    if (isClicked && !onCooldown) {
-        // This code runs once on click, only if not on cooldown
-        clickTime = SDL_GetTicks();
-        onCooldown = true;
+    if (isClicked) {
+        // This code runs once per click accepted by handleEvent
         isClicked = false;
         onClick();
     }
 
-    if (onCooldown && SDL_GetTicks() - clickTime >= static_cast<uint32_t>(cooldownDuration)) {
+    if (onCooldown && state.clock->nowNS() >= clickTime + SDL_MS_TO_NS(cooldownDuration)) {
         // Cooldown is over
         onCooldown = false;
     }
@@ -123,15 +113,25 @@ void CuttingGame::handleEvent(const SDL_Event& event) {
     case SDL_EVENT_MOUSE_BUTTON_DOWN:
         mouseX = event.button.x;
         mouseY = event.button.y;
-        if (event.button.button == SDL_BUTTON_LEFT && !onCooldown) {
-            isClicked = true;
+        if (event.button.button == SDL_BUTTON_LEFT) {
+            // Judge the click when and where it happened, the knife may have moved by the next update
+            uint64_t when = state.clock->gameTimeAt(event.button.timestamp);
+            //Timestamps can be earlier than the last click's, that is still within its cooldown
+            if (onCooldown && when >= clickTime && when - clickTime >= SDL_MS_TO_NS(cooldownDuration)) {
+                onCooldown = false;
+            }
+            if (!onCooldown && !isClicked) {
+                isClicked = true;
+                onCooldown = true;
+                clickTime = when;
+                clickX = mouseX - knifeRect.w / 2;
+            }
         }
         break;
 
     case SDL_EVENT_MOUSE_BUTTON_UP:
         mouseX = event.button.x;
         mouseY = event.button.y;
-        isClicked = false;
         break;
     }
 
@@ -151,12 +151,12 @@ void CuttingGame::onClick() {
 
     for (int i = 0; i < ingrRects.size(); i++) {
         SDL_FRect rect = ingrRects[i].destRect;
-        knifeOverRect = knifeRect.x >= rect.x && knifeRect.x + knifeRect.w <= rect.x + rect.w;
+        knifeOverRect = clickX >= rect.x && clickX + knifeRect.w <= rect.x + rect.w;
 
         if (knifeOverRect && !isComplete()) {
             cutMade = true;
             index = i;
-            float cutPoint = knifeRect.x + (knifeRect.w / 2);
+            float cutPoint = clickX + (knifeRect.w / 2);
 
             // Display rectangles (for positioning)
             leftDisplayRect = {
@@ -248,30 +248,23 @@ void CuttingGame::updateProgress()
 }
 
 //Helper function to get ingredient file path, important that we follow filename conventions
-SDL_Texture* CuttingGame::getIngrTexture(SDL_Renderer* renderer, Ingredient ingr) {
+TextureHandle CuttingGame::getIngrTexture(Ingredient ingr) {
     string filepath = "src/res/sprites/ingredients/" + ingr.name + ".png";
-    SDL_Texture* texture;
-    try {
-        texture = IMG_LoadTexture(renderer, filepath.c_str());
-    }
-    catch (int e) {
-        cout << "Error loading texture: " << e;
-        texture = IMG_LoadTexture(renderer, "src/res/sprites/no_texture.png");
+    TextureHandle texture = state.textures->acquire(filepath);
+    if (!texture) {
+        texture = state.textures->acquire(Sprites::Shared::PATHS[Sprites::Shared::NO_TEXTURE]);
     }
     return texture;
 }
 
 //Load textures need for minigame
 void CuttingGame::loadTextures() {
-    textures["background"] = IMG_LoadTexture(state.renderer, "src/res/sprites/cutting_game/bg.png");
-    textures["knife"] = IMG_LoadTexture(state.renderer, "src/res/sprites/cutting_game/dotted.png");
-    textures[ingr.name] = getIngrTexture(state.renderer, ingr);
+    textures.acquireAsync(state.textures, Sprites::CuttingGame::BG);
+    textures.acquireAsync(state.textures, Sprites::CuttingGame::DOTTED); //The knife's dotted line
+    ingrTexture = getIngrTexture(ingr);
 }
 
 void CuttingGame::cleanup() {
-    for (auto& pair : textures) {
-        SDL_DestroyTexture(pair.second);
-    }
-
-    textures.clear();
+    textures.reset(); //Releases our references, the cache keeps them around for a while
+    ingrTexture.reset();
 }
\ No newline at end of file
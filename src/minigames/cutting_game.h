@@ -2,10 +2,12 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
-#include <unordered_map>
 #include <vector>
 #include "minigame.h"
 #include "../data_structs.h"
+#include "../texture_cache.h"
+#include "../asset_ids.h"
+#include "../text_label.h"
 
 using namespace std;
 
@@ -13,7 +15,8 @@ class CuttingGame : public Minigame { //Base your minigame off of this one
 public:
 	CuttingGame(SDLState& state, CookingStep step);
 	~CuttingGame();
-	void render() override;
+	void begin() override;
+	void render(float alpha) override;
 	void update() override;
 	void handleEvent(const SDL_Event& event) override;
 	bool isComplete() const override;
@@ -23,7 +26,7 @@ public:
 private:
 	void spaceRectangles();
 	void loadTextures();
-	SDL_Texture* getIngrTexture(SDL_Renderer* renderer, Ingredient ingr);
+	TextureHandle getIngrTexture(Ingredient ingr);
 	void cleanup();
 	void onClick();
 	void updateProgress();
@@ -31,7 +34,8 @@ private:
 	SDLState& state;
 	CookingStep step;
 	Ingredient ingr;
-	unordered_map<string, SDL_Texture*> textures;
+	SpriteSet<Sprites::CuttingGame> textures;
+	TextureHandle ingrTexture; //The ingredient being prepared, from the ingredients folder
 
 	//Struct for holding rectangles of each cut ingredient
 	struct Rectangles {
@@ -42,9 +46,11 @@ private:
 	SDL_FRect progressBarBG; //Background rect for progress bar
 	SDL_FRect progressBar; //rect for progress bar
 	vector<Rectangles> ingrRects;
-	uint64_t clickTime;
+	uint64_t clickTime; //Game time of the last accepted click in ns, taken from its event
+	float clickX; //Where the knife was when it was clicked
 	bool isClicked;
 	bool onCooldown;
-	const int cooldownDuration = 100;
+	const Uint64 cooldownDuration = 100; //ms
 	int cutsMade = 0;
+	TextLabel cutsLabel; //Only re-laid out when the cut count changes
 };
\ No newline at end of file
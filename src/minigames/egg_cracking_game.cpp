@@ -1,4 +1,9 @@
 #include "egg_cracking_game.h"
+#include "../text_renderer.h"
+#include "../font_manager.h"
+#include "../string_table.h"
+#include "../asset_ids.h"
+#include "../clock.h"
 
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_image/SDL_image.h>
@@ -38,14 +43,18 @@ EggCrackingGame::EggCrackingGame(SDLState& state, const CookingStep& step, Mode
 
     configureLayout();
     loadTextures();
+    loadCaptions();
 
     zoneRects.resize(3);
     zoneHit.assign(3, false);
 
-    countdownStartTick = SDL_GetTicks();
     stateMachine = State::Countdown;
 }
 
+void EggCrackingGame::begin() {
+    countdownStartTick = state.clock->nowMS();
+}
+
 EggCrackingGame::~EggCrackingGame() {
     cleanupTextures();
 }
@@ -110,35 +119,53 @@ void EggCrackingGame::configureLayout() {
 void EggCrackingGame::loadTextures() {
     // images placed in src/res/sprites/egg_game/
 
-    texBackground = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/bg_kitchen.png");
-    texBowl = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/bowl.png");
-    texHandIdle = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/hand_idle.png");
-    texHandCrack = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/hand_crack.png");
-    texYolk = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/yolk.png");
+    texBackground = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::BG_KITCHEN]);
+    texBowl = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::BOWL]);
+    texHandIdle = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::HAND_IDLE]);
+    texHandCrack = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::HAND_CRACK]);
+    texYolk = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::YOLK]);
 
-    texResult[0] = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/egg_result_0.png");
-    texResult[1] = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/egg_result_1.png");
-    texResult[2] = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/egg_result_2.png");
-    texResult[3] = IMG_LoadTexture(state.renderer, "src/res/sprites/egg_game/egg_result_3.png");
+    texResult[0] = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::EGG_RESULT_0]);
+    texResult[1] = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::EGG_RESULT_1]);
+    texResult[2] = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::EGG_RESULT_2]);
+    texResult[3] = state.textures->acquireAsync(Sprites::EggGame::PATHS[Sprites::EggGame::EGG_RESULT_3]);
 }
 
 void EggCrackingGame::cleanupTextures() {
-    if (texBackground) SDL_DestroyTexture(texBackground);
-    if (texBowl) SDL_DestroyTexture(texBowl);
-    if (texHandIdle) SDL_DestroyTexture(texHandIdle);
-    if (texHandCrack) SDL_DestroyTexture(texHandCrack);
-    if (texYolk) SDL_DestroyTexture(texYolk);
+    texBackground.reset();
+    texBowl.reset();
+    texHandIdle.reset();
+    texHandCrack.reset();
+    texYolk.reset();
 
     for (int i = 0; i < 4; ++i) {
-        if (texResult[i]) SDL_DestroyTexture(texResult[i]);
-        texResult[i] = nullptr;
+        texResult[i].reset();
+    }
+}
+
+// Shapes the fixed strings up front. Result captions zoom up to RESULT_CAPTION_MAX_SCALE, so
+// they are laid out from a font that size and only ever scaled down, which keeps them crisp
+// without re-rasterizing per frame
+void EggCrackingGame::loadCaptions() {
+    if (!state.font || !state.strings) return;
+
+    state.strings->prepare(mode == Mode::Normal ? StringId::CrackInstructions : StringId::CrackInstructionsEndless, state.font);
+    state.strings->prepare(StringId::Go, state.font);
+
+    captionFont = nullptr;
+    if (state.fonts) {
+        captionFont = state.fonts->getSizedFont(state.font, TTF_GetFontSize(state.font) * RESULT_CAPTION_MAX_SCALE);
+    }
+    if (captionFont) {
+        resultCaptionFontScale = RESULT_CAPTION_MAX_SCALE;
+    } else {
+        captionFont = state.font;
+        resultCaptionFontScale = 1.0f;
     }
 
-    texBackground = nullptr;
-    texBowl = nullptr;
-    texHandIdle = nullptr;
-    texHandCrack = nullptr;
-    texYolk = nullptr;
+    for (StringId caption : RESULT_CAPTIONS) {
+        state.strings->prepare(caption, captionFont);
+    }
 }
 
 // -------- Zone layout --------
@@ -176,11 +203,16 @@ void EggCrackingGame::generateZonesForCurrentEgg() {
 
 void EggCrackingGame::startNewEgg() {
     generateZonesForCurrentEgg();
-    passStartTick = SDL_GetTicks();
+    passStartNS = state.clock->nowNS();
     stateMachine = State::Active;
     crackAnimState = CrackAnimState::Idle;
     handRect = handIdlePos;
     yolkActive = false;
+
+    //Jump back to the start of the bar rather than sweeping there
+    markerRect.x = barRect.x;
+    prevMarkerRect = markerRect;
+    prevHandRect = handRect;
 }
 
 void EggCrackingGame::finishCurrentEgg() {
@@ -193,7 +225,7 @@ void EggCrackingGame::finishCurrentEgg() {
         eggFailed = false; // ignored in Normal mode
     }
 
-    resultStartTick = SDL_GetTicks();
+    resultStartTick = state.clock->nowMS();
     stateMachine = State::EggResult;
 }
 
@@ -227,7 +259,9 @@ void EggCrackingGame::finishMinigame() {
 // -------- Update --------
 
 void EggCrackingGame::update() {
-    uint64_t now = SDL_GetTicks();
+    uint64_t now = state.clock->nowMS();
+    prevMarkerRect = markerRect;
+    prevHandRect = handRect;
 
     // Update / clean fading hit markers
     updateHitFeedbacks(static_cast<uint32_t>(now));
@@ -242,17 +276,13 @@ void EggCrackingGame::update() {
     }
 
     case State::Active: {
-        uint64_t elapsed = now - passStartTick;
-
         // Move marker along bar in a single pass
-        float t = std::min(1.0f,
-            static_cast<float>(elapsed) / static_cast<float>(passDurationMs));
-        markerRect.x = barRect.x + t * (barRect.w - markerRect.w);
+        markerRect.x = markerXAt(state.clock->nowNS());
 
         // Update crack animation while active
         updateCrackAnimation(now);
 
-        if (elapsed >= passDurationMs) {
+        if (state.clock->nowNS() - passStartNS >= passDurationMs * SDL_NS_PER_MS) {
             finishCurrentEgg();
         }
         break;
@@ -269,7 +299,7 @@ void EggCrackingGame::update() {
                 if (currentEgg >= totalEggs) {
                     finishMinigame();
                 } else {
-                    countdownStartTick = SDL_GetTicks();
+                    countdownStartTick = state.clock->nowMS();
                     stateMachine = State::Countdown;
                     crackAnimState = CrackAnimState::Idle;
                     handRect = handIdlePos;
@@ -289,7 +319,7 @@ void EggCrackingGame::update() {
                         static_cast<uint32_t>(passDurationMs * speedMultiplier)
                     );
 
-                    countdownStartTick = SDL_GetTicks();
+                    countdownStartTick = state.clock->nowMS();
                     stateMachine = State::Countdown;
                     crackAnimState = CrackAnimState::Idle;
                     handRect = handIdlePos;
@@ -375,14 +405,20 @@ void EggCrackingGame::handleEvent(const SDL_Event& event) {
     if (stateMachine != State::Active) return;
 
     if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_SPACE) {
-        handleSpacePress();
+        // Judged at the moment the key went down, not where the last update left the marker
+        handleSpacePress(state.clock->gameTimeAt(event.key.timestamp));
     }
 }
 
-void EggCrackingGame::handleSpacePress() {
+void EggCrackingGame::handleSpacePress(Uint64 pressNS) {
     if (pressesThisEgg >= pressesPerEgg) {
         return;
     }
+    // Pressed after the pass ended, the update that ends the egg just hasn't run yet
+    if (pressNS > passStartNS && pressNS - passStartNS >= passDurationMs * SDL_NS_PER_MS) {
+        return;
+    }
+    float markerX = markerXAt(pressNS);
 
     pressesThisEgg++;
 
@@ -390,7 +426,7 @@ void EggCrackingGame::handleSpacePress() {
     for (size_t i = 0; i < zoneRects.size(); ++i) {
         if (zoneHit[i]) continue;
 
-        if (markerInZone(static_cast<int>(i))) {
+        if (markerInZone(static_cast<int>(i), markerX)) {
             zoneHit[i] = true;
             hitsThisEgg++;
             hitZone = true;
@@ -401,7 +437,7 @@ void EggCrackingGame::handleSpacePress() {
     // Fading marker for hit or miss
     {
         HitFeedback fb;
-        float centerX = markerRect.x + markerRect.w * 0.5f;
+        float centerX = markerX + markerRect.w * 0.5f;
         fb.rect.w = markerRect.w * 1.2f;
         fb.rect.h = barRect.h + 8.0f;
         fb.rect.x = centerX - fb.rect.w * 0.5f;
@@ -413,7 +449,7 @@ void EggCrackingGame::handleSpacePress() {
             fb.color = SDL_Color{255, 80, 80, 220};    // red for miss
         }
 
-        fb.spawnTime  = SDL_GetTicks();
+        fb.spawnTime  = state.clock->nowMS();
         fb.lifetimeMs = 400; // fades over 0.4s
 
         hitFeedbacks.push_back(fb);
@@ -421,7 +457,7 @@ void EggCrackingGame::handleSpacePress() {
 
     // Trigger crack animation
     crackAnimState = CrackAnimState::CrackDown;
-    crackAnimStartMs = SDL_GetTicks();
+    crackAnimStartMs = state.clock->nowMS();
 
     // If we've already used all presses or hit all zones, end this egg
     if (hitsThisEgg >= static_cast<int>(zoneRects.size()) ||
@@ -430,11 +466,18 @@ void EggCrackingGame::handleSpacePress() {
     }
 }
 
-bool EggCrackingGame::markerInZone(int zoneIndex) const {
+float EggCrackingGame::markerXAt(Uint64 timeNS) const {
+    Uint64 elapsed = timeNS > passStartNS ? timeNS - passStartNS : 0;
+    double t = std::min(1.0,
+        static_cast<double>(elapsed) / (static_cast<double>(passDurationMs) * SDL_NS_PER_MS));
+    return barRect.x + static_cast<float>(t) * (barRect.w - markerRect.w);
+}
+
+bool EggCrackingGame::markerInZone(int zoneIndex, float markerX) const {
     const SDL_FRect& zr = zoneRects[zoneIndex];
 
-    float markerLeft = markerRect.x;
-    float markerRight = markerRect.x + markerRect.w;
+    float markerLeft = markerX;
+    float markerRight = markerX + markerRect.w;
     float zoneLeft = zr.x;
     float zoneRight = zr.x + zr.w;
 
@@ -444,13 +487,13 @@ bool EggCrackingGame::markerInZone(int zoneIndex) const {
 
 // -------- Render --------
 
-void EggCrackingGame::render() {
+void EggCrackingGame::render(float alpha) {
     renderBackground();
-    renderKitchen();
+    renderKitchen(alpha);
     renderBar();
     renderZones();
     renderHitFeedback(); // draw fading hit markers on top of zones
-    renderMarker();
+    renderMarker(alpha);
     renderUI();
 
     switch (stateMachine) {
@@ -472,7 +515,7 @@ void EggCrackingGame::renderBackground() {
     SDL_Renderer* renderer = state.renderer;
 
     if (texBackground) {
-        SDL_RenderTexture(renderer, texBackground, nullptr, nullptr);
+        texBackground.render(renderer, nullptr, nullptr);
         return;
     }
 
@@ -486,32 +529,33 @@ void EggCrackingGame::renderBackground() {
     SDL_RenderFillRect(renderer, &bg);
 }
 
-void EggCrackingGame::renderKitchen() {
+void EggCrackingGame::renderKitchen(float alpha) {
     SDL_Renderer* renderer = state.renderer;
 
     // Bowl
     if (texBowl) {
-        SDL_RenderTexture(renderer, texBowl, nullptr, &bowlRect);
+        texBowl.render(renderer, nullptr, &bowlRect);
     } else {
         SDL_SetRenderDrawColor(renderer, 120, 80, 80, SDL_ALPHA_OPAQUE);
         SDL_RenderFillRect(renderer, &bowlRect);
     }
 
     // Hand
-    SDL_Texture* handTex = nullptr;
+    const TextureHandle* handTex = nullptr;
     if (crackAnimState == CrackAnimState::CrackDown ||
         crackAnimState == CrackAnimState::Impact ||
         crackAnimState == CrackAnimState::CrackUp) {
-        handTex = texHandCrack ? texHandCrack : texHandIdle;
+        handTex = texHandCrack ? &texHandCrack : &texHandIdle;
     } else {
-        handTex = texHandIdle;
+        handTex = &texHandIdle;
     }
 
-    if (handTex) {
-        SDL_RenderTexture(renderer, handTex, nullptr, &handRect);
+    SDL_FRect hand = interpolate(prevHandRect, handRect, alpha);
+    if (*handTex) {
+        handTex->render(renderer, nullptr, &hand);
     } else {
         SDL_SetRenderDrawColor(renderer, 200, 200, 220, SDL_ALPHA_OPAQUE);
-        SDL_RenderFillRect(renderer, &handRect);
+        SDL_RenderFillRect(renderer, &hand);
     }
 }
 
@@ -549,10 +593,10 @@ void EggCrackingGame::renderZones() {
     }
 }
 
-void EggCrackingGame::renderMarker() {
+void EggCrackingGame::renderMarker(float alpha) {
     SDL_Renderer* renderer = state.renderer;
 
-    SDL_FRect rect = markerRect;
+    SDL_FRect rect = interpolate(prevMarkerRect, markerRect, alpha);
 
     SDL_SetRenderDrawColor(renderer, 255, 105, 180, SDL_ALPHA_OPAQUE);
     SDL_RenderFillRect(renderer, &rect);
@@ -560,7 +604,7 @@ void EggCrackingGame::renderMarker() {
 
 void EggCrackingGame::renderHitFeedback() {
     SDL_Renderer* renderer = state.renderer;
-    uint64_t now = SDL_GetTicks();
+    uint64_t now = state.clock->nowMS();
 
     for (const auto& fb : hitFeedbacks) {
         uint64_t age = now - fb.spawnTime;
@@ -583,29 +627,29 @@ void EggCrackingGame::renderUI() {
     SDL_Color white{255, 255, 255, SDL_ALPHA_OPAQUE};
     SDL_Color ghost{170, 210, 255, SDL_ALPHA_OPAQUE};
 
-    std::string eggText;
+    char eggText[64];
 
     if (mode == Mode::Normal) {
-        eggText = "EGG " + to_string(currentEgg + 1) + " / " + to_string(totalEggs);
+        SDL_snprintf(eggText, sizeof(eggText), state.strings->get(StringId::EggCountFmt), currentEgg + 1, totalEggs);
     } else {
         // Endless: show how many eggs you’ve survived so far
-        eggText = "EGGS CRACKED: " + to_string(currentEgg);
+        SDL_snprintf(eggText, sizeof(eggText), state.strings->get(StringId::EggsCrackedFmt), currentEgg);
     }
 
-    renderTextCentered(eggText, state.logH * 0.10f, white);
+    renderLabelCentered(eggCountLabel, eggText, state.logH * 0.10f, white);
 
-    std::string info;
+    StringId info;
     if (mode == Mode::Normal) {
-        info = "Press SPACE to crack!";
+        info = StringId::CrackInstructions;
     } else {
-        info = "Press SPACE to crack! Don't miss!";
+        info = StringId::CrackInstructionsEndless;
     }
 
-    renderTextCentered(info, state.logH * 0.16f, ghost);
+    state.strings->draw(info, state.font, state.logW / 2.0f, state.logH * 0.16f, ghost, 0.5f, 0.5f);
 }
 
 void EggCrackingGame::renderCountdown() {
-    uint64_t now = SDL_GetTicks();
+    uint64_t now = state.clock->nowMS();
     uint64_t elapsed = now - countdownStartTick;
 
     uint64_t remaining = (elapsed >= countdownDurationMs)
@@ -614,20 +658,19 @@ void EggCrackingGame::renderCountdown() {
 
     int secondsLeft = static_cast<int>(std::ceil(remaining / 1000.0f));
 
-    string text;
+    SDL_Color yellow{ 255, 230, 150, SDL_ALPHA_OPAQUE };
     if (secondsLeft > 0) {
-        text = "Ready? " + to_string(secondsLeft);
+        char text[32];
+        SDL_snprintf(text, sizeof(text), state.strings->get(StringId::ReadyFmt), secondsLeft);
+        renderLabelCentered(countdownLabel, text, state.logH * 0.30f, yellow);
     } else {
-        text = "Go!";
+        state.strings->draw(StringId::Go, state.font, state.logW / 2.0f, state.logH * 0.30f, yellow, 0.5f, 0.5f);
     }
-
-    SDL_Color yellow{ 255, 230, 150, SDL_ALPHA_OPAQUE };
-    renderTextCentered(text, state.logH * 0.30f, yellow);
 }
 
 void EggCrackingGame::renderEggResultOverlay() {
     SDL_Renderer* renderer = state.renderer;
-    uint64_t now = SDL_GetTicks();
+    uint64_t now = state.clock->nowMS();
 
     float t = std::min(1.0f,
         (now - resultStartTick) / static_cast<float>(resultDurationMs));
@@ -650,12 +693,6 @@ void EggCrackingGame::renderEggResultOverlay() {
     else if (hitsThisEgg == 1) tier = 1;
     else tier = 0;
 
-    string text;
-    if (tier == 3) text = "PERFECT CRACK!";
-    else if (tier == 2) text = "Almost EGGcelent!";
-    else if (tier == 1) text = "You're messy...";
-    else text = "You got shell everywhere!";
-
     // 3. Zoom animation factor (0.6 -> 1.1 -> 1.0)
     float scale;
     if (t < 0.5f) {
@@ -683,10 +720,10 @@ void EggCrackingGame::renderEggResultOverlay() {
         eggH
     };
 
-    SDL_Texture* resTex = texResult[tier];
+    const TextureHandle& resTex = texResult[tier];
 
     if (resTex) {
-        SDL_RenderTexture(renderer, resTex, nullptr, &eggRect);
+        resTex.render(renderer, nullptr, &eggRect);
     } else {
         // fallback colours if no texture
         if (tier == 3) SDL_SetRenderDrawColor(renderer, 255, 230, 80, SDL_ALPHA_OPAQUE);
@@ -697,69 +734,26 @@ void EggCrackingGame::renderEggResultOverlay() {
         SDL_RenderFillRect(renderer, &eggRect);
     }
 
-    // 5. Draw text above the image, centered
-    if (state.font) {
-        SDL_Color txtColor{ 255, 255, 255, SDL_ALPHA_OPAQUE };
-        SDL_Surface* surf = TTF_RenderText_Solid(state.font, text.c_str(), 0, txtColor);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            if (tex) {
-                float tw, th;
-                SDL_GetTextureSize(tex, &tw, &th);
-
-                SDL_FRect dst{
-                    centerX - tw / 2.0f,
-                    eggRect.y - th - 20.0f,  // above egg
-                    tw,
-                    th
-                };
-
-                SDL_RenderTexture(renderer, tex, nullptr, &dst);
-                SDL_DestroyTexture(tex);
-            }
-            SDL_DestroySurface(surf);
-        }
-    }
+    // 5. Draw text above the image, centered, zooming with the egg
+    SDL_Color txtColor{ 255, 255, 255, SDL_ALPHA_OPAQUE };
+    state.strings->draw(RESULT_CAPTIONS[tier], captionFont, centerX, eggRect.y - 20.0f, txtColor,
+        0.5f, 1.0f, scale / resultCaptionFontScale); // above egg
 }
 
 void EggCrackingGame::renderDoneText() {
     SDL_Color gold{255, 215, 0, SDL_ALPHA_OPAQUE};
 
-    string text;
+    char text[96];
     if (mode == Mode::Normal) {
-        text = "All eggs cracked! Score: " + to_string(finalScore) + "/100";
+        SDL_snprintf(text, sizeof(text), state.strings->get(StringId::AllEggsCrackedFmt), finalScore);
     } else {
-        text = "Game over! Eggs cracked: " + to_string(finalScore);
+        SDL_snprintf(text, sizeof(text), state.strings->get(StringId::EndlessGameOverFmt), finalScore);
     }
 
-    renderTextCentered(text, state.logH * 0.32f, gold);
+    renderLabelCentered(doneLabel, text, state.logH * 0.32f, gold);
 }
 
-void EggCrackingGame::renderTextCentered(const string& text, float y, SDL_Color color) {
-    if (!state.font) return;
-
-    SDL_Renderer* renderer = state.renderer;
-
-    SDL_Surface* surf = TTF_RenderText_Solid(state.font, text.c_str(), 0, color);
-    if (!surf) return;
-
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (!tex) {
-        SDL_DestroySurface(surf);
-        return;
-    }
-
-    float tw, th;
-    SDL_GetTextureSize(tex, &tw, &th);
-
-    SDL_FRect dst{
-        (state.logW - tw) / 2.0f,
-        y - th / 2.0f,
-        tw,
-        th
-    };
-
-    SDL_RenderTexture(renderer, tex, nullptr, &dst);
-    SDL_DestroyTexture(tex);
-    SDL_DestroySurface(surf);
+void EggCrackingGame::renderLabelCentered(TextLabel& label, const char* text, float y, SDL_Color color) {
+    label.setText(state.text, state.font, text, color);
+    label.render(state.logW / 2.0f, y, 0.5f, 0.5f);
 }
@@ -7,7 +7,10 @@
 #include <random>
 #include <string>
 #include "../data_structs.h"
+#include "../texture_cache.h"
 #include "minigame.h"
+#include "../text_label.h"
+#include "../string_table.h"
 
 class EggCrackingGame : public Minigame {
 public:
@@ -19,8 +22,9 @@ public:
 
     EggCrackingGame(SDLState& state, const CookingStep& step, Mode mode = Mode::Normal);
     ~EggCrackingGame();
+    void begin() override;
 
-    void render() override;
+    void render(float alpha) override;
     void update() override;
     void handleEvent(const SDL_Event& event) override;
     bool isComplete() const override;
@@ -79,7 +83,7 @@ private:
     uint32_t resultDurationMs = 900;  // per-egg result overlay display
 
     uint64_t countdownStartTick = 0;
-    uint64_t passStartTick = 0;
+    uint64_t passStartNS = 0; // game time in ns, so presses can be judged between ticks
     uint64_t resultStartTick = 0;
     uint64_t crackAnimStartMs = 0;
 
@@ -91,14 +95,16 @@ private:
     SDL_FRect handCrackPos{};
     SDL_FRect handRect{};
     SDL_FRect yolkRect{}; // not currently animated
+    SDL_FRect prevMarkerRect{}; // before the last update, rendering interpolates from these
+    SDL_FRect prevHandRect{};
 
     // Textures
-    SDL_Texture* texBackground = nullptr;
-    SDL_Texture* texBowl = nullptr;
-    SDL_Texture* texHandIdle = nullptr;
-    SDL_Texture* texHandCrack = nullptr;
-    SDL_Texture* texYolk = nullptr;
-    SDL_Texture* texResult[4] = { nullptr, nullptr, nullptr, nullptr };
+    TextureHandle texBackground;
+    TextureHandle texBowl;
+    TextureHandle texHandIdle;
+    TextureHandle texHandCrack;
+    TextureHandle texYolk;
+    TextureHandle texResult[4];
 
     // Zones on the bar
     std::vector<SDL_FRect> zoneRects;
@@ -114,12 +120,29 @@ private:
     // Fading hit markers
     std::vector<HitFeedback> hitFeedbacks;
 
+    // HUD text, only re-laid out when the shown value changes
+    TextLabel eggCountLabel;
+    TextLabel countdownLabel;
+    TextLabel doneLabel;
+
+    // Per-tier result captions, shaped once at the largest zoom
+    const StringId RESULT_CAPTIONS[4] = {
+        StringId::CrackResultShell,
+        StringId::CrackResultMessy,
+        StringId::CrackResultAlmost,
+        StringId::CrackResultPerfect
+    };
+    const float RESULT_CAPTION_MAX_SCALE = 1.1f;
+    float resultCaptionFontScale = 1.0f;
+    TTF_Font* captionFont = nullptr; // owned by state.fonts
+
     // -------- Internal helpers --------
 
     // Layout / assets
     void configureLayout();
     void loadTextures();
     void cleanupTextures();
+    void loadCaptions();
 
     // Zones & eggs
     void generateZonesForCurrentEgg();
@@ -130,19 +153,20 @@ private:
     // Logic
     void updateCrackAnimation(uint64_t now);
     void updateHitFeedbacks(uint64_t now);
-    void handleSpacePress();
-    bool markerInZone(int zoneIndex) const;
+    void handleSpacePress(Uint64 pressNS);
+    float markerXAt(Uint64 timeNS) const;
+    bool markerInZone(int zoneIndex, float markerX) const;
 
     // Render
     void renderBackground();
-    void renderKitchen();
+    void renderKitchen(float alpha);
     void renderBar();
     void renderZones();
-    void renderMarker();
+    void renderMarker(float alpha);
     void renderHitFeedback();
     void renderUI();
     void renderCountdown();
     void renderEggResultOverlay();
     void renderDoneText();
-    void renderTextCentered(const std::string& text, float y, SDL_Color color);
+    void renderLabelCentered(TextLabel& label, const char* text, float y, SDL_Color color);
 };
@@ -6,12 +6,13 @@
 #include "frying_game.h"
 #include "minigame.h"
 #include "../data_structs.h"
+#include "../clock.h"
 
 using namespace std;
 
 FryingGame::FryingGame(SDLState& state, CookingStep step)
-    : state(state), step(step), startTime(SDL_GetTicks()),
-    currentTime(SDL_GetTicks()), progressTime(0),
+    : state(state), step(step), startTime(state.clock->nowMS()),
+    currentTime(state.clock->nowMS()), progressTime(0),
     safeZoneSpeed(100.0f), safeZoneVX(100.0f), safeZoneVY(100.0f),
     dialAngleX(0), dialAngleY(0),
     gameField(475, 40, 250, 250), safeZone(570, 70, 50, 50), mouseRect(570, 70, 10, 10),
@@ -20,30 +21,50 @@ FryingGame::FryingGame(SDLState& state, CookingStep step)
 {
     ingr = step.ingredients[0]; //Maybe update this to check if the array is empty later im too lazy
     loadTextures(); //Load all textures for this minigame
-    SDL_SetWindowRelativeMouseMode(state.window, true);
+}
+
+void FryingGame::begin()
+{
+    startTime = state.clock->nowMS();
+    currentTime = startTime;
+    grabMouse();
+
+    //Start the cursor where the square is
+    float windowX, windowY;
+    SDL_RenderCoordinatesToWindow(state.renderer, mouseRect.x + mouseRect.w / 2, mouseRect.y + mouseRect.h / 2, &windowX, &windowY);
+    SDL_WarpMouseInWindow(state.window, windowX, windowY);
+
+    prevSafeZone = safeZone;
+    prevProgressBar = progressBar;
+    prevDialAngleX = dialAngleX;
+    prevDialAngleY = dialAngleY;
 }
 
 FryingGame::~FryingGame()
 {
-    SDL_SetWindowRelativeMouseMode(state.window, false);
+    confineMouse(state.window, state.renderer, nullptr);
+    cursor.reset();
     cleanup();
 }
 
-void FryingGame::render()
+void FryingGame::render(float alpha)
 {
     SDL_Renderer* renderer = state.renderer;
 
     //Render background
-    SDL_RenderTexture(renderer, textures["background"], nullptr, nullptr);
+    textures[Sprites::FryingGame::BACKGROUND_FRYING].render(renderer, nullptr, nullptr);
 
     //Render gamefield
     SDL_RenderFillRect(renderer, &gameField);
     //Render safezone
+    SDL_FRect safeZoneRect = interpolate(prevSafeZone, safeZone, alpha);
     SDL_SetRenderDrawColor(renderer, 18, 223, 176, SDL_ALPHA_OPAQUE);
-    SDL_RenderFillRect(renderer, &safeZone);
-    //Render mouse rect
-    SDL_SetRenderDrawColor(renderer, 255, 10, 225, SDL_ALPHA_OPAQUE);
-    SDL_RenderFillRect(renderer, &mouseRect);
+    SDL_RenderFillRect(renderer, &safeZoneRect);
+    //Render mouse rect when there's no hardware cursor, where inSafeZone() judges it to be
+    if (!cursor) {
+        SDL_SetRenderDrawColor(renderer, 255, 10, 225, SDL_ALPHA_OPAQUE);
+        SDL_RenderFillRect(renderer, &mouseRect);
+    }
 
     //render the progress bar
     // Fill
@@ -53,21 +74,29 @@ void FryingGame::render()
     SDL_SetRenderDrawColor(renderer, 220, 220, 240, SDL_ALPHA_OPAQUE);
     SDL_RenderRect(renderer, &progressBarBG);
 
+    SDL_FRect progressRect = interpolate(prevProgressBar, progressBar, alpha);
     SDL_SetRenderDrawColor(renderer, 255, 10, 225, SDL_ALPHA_OPAQUE);
-    SDL_RenderFillRect(renderer, &progressBar);
+    SDL_RenderFillRect(renderer, &progressRect);
 
     //Render dials
-    SDL_RenderTextureRotated(renderer, textures["dial"], nullptr, &dialRectX, dialAngleX, nullptr, SDL_FLIP_NONE);
-    SDL_RenderTextureRotated(renderer, textures["dial"], nullptr, &dialRectY, dialAngleY, nullptr, SDL_FLIP_NONE);
+    double angleX = prevDialAngleX + (dialAngleX - prevDialAngleX) * alpha;
+    double angleY = prevDialAngleY + (dialAngleY - prevDialAngleY) * alpha;
+    textures[Sprites::FryingGame::DIAL].renderRotated(renderer, nullptr, &dialRectX, angleX, SDL_FLIP_NONE);
+    textures[Sprites::FryingGame::DIAL].renderRotated(renderer, nullptr, &dialRectY, angleY, SDL_FLIP_NONE);
 
     // Render ingredient texture with aspect ratio preserved
-    SDL_FRect aspectRect = getAspectRatioRect(textures[ingr.name], ingrRect);
-    SDL_RenderTexture(renderer, textures[ingr.name], nullptr, &aspectRect);
+    SDL_FRect aspectRect = getAspectRatioRect(ingrTexture, ingrRect);
+    ingrTexture.render(renderer, nullptr, &aspectRect);
 }
 
 void FryingGame::update()
 {
-    currentTime = SDL_GetTicks(); //update current time
+    currentTime = state.clock->nowMS(); //update current time
+    prevSafeZone = safeZone;
+    prevProgressBar = progressBar;
+    prevDialAngleX = dialAngleX;
+    prevDialAngleY = dialAngleY;
+
     updateProgress();
     updateSafeZone();
     updateDials();
@@ -85,12 +114,13 @@ void FryingGame::handleEvent(const SDL_Event& event)
         tempX = mouseX - mouseRect.w / 2;
         tempY = mouseY - mouseRect.h / 2;
 
-        if (tempX >= gameField.x && tempX + mouseRect.w <= gameField.x + gameField.w) {
-            mouseRect.x = tempX;
-        }
-        if (tempY >= gameField.y && tempY + mouseRect.h <= gameField.y + gameField.h) {
-            mouseRect.y = tempY;
-        }
+        //The mouse is confined to the field, clamping only covers rounding at its edges
+        mouseRect.x = SDL_clamp(tempX, gameField.x, gameField.x + gameField.w - mouseRect.w);
+        mouseRect.y = SDL_clamp(tempY, gameField.y, gameField.y + gameField.h - mouseRect.h);
+        break;
+
+    case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED: //The field and the cursor change size on screen
+        grabMouse();
         break;
 
     case SDL_EVENT_MOUSE_BUTTON_DOWN:
@@ -231,11 +261,14 @@ bool FryingGame::inSafeZone()
     return false;
 }
 
-SDL_FRect FryingGame::getAspectRatioRect(SDL_Texture* texture, const SDL_FRect& targetRect)
+SDL_FRect FryingGame::getAspectRatioRect(const TextureHandle& texture, const SDL_FRect& targetRect)
 {
     // Get the original texture dimensions
-    float textureWidth, textureHeight;
-    SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+    float textureWidth = texture.getWidth();
+    float textureHeight = texture.getHeight();
+    if (textureWidth <= 0.0f || textureHeight <= 0.0f) {
+        return targetRect;
+    }
 
     // Calculate aspect ratios
     float textureAspect = textureWidth / textureHeight;
@@ -262,30 +295,38 @@ SDL_FRect FryingGame::getAspectRatioRect(SDL_Texture* texture, const SDL_FRect&
 }
 
 //Helper function to get ingredient file path, important that we follow filename conventions
-SDL_Texture* FryingGame::getIngrTexture(SDL_Renderer* renderer, Ingredient ingr) {
+TextureHandle FryingGame::getIngrTexture(Ingredient ingr) {
     string filepath = "src/res/sprites/ingredients/" + ingr.name + ".png";
-    SDL_Texture* texture;
-    try {
-        texture = IMG_LoadTexture(renderer, filepath.c_str());
-    }
-    catch (int e) {
-        cout << "Error loading texture: " << e;
-        texture = IMG_LoadTexture(renderer, "src/res/sprites/no_texture.png");
+    TextureHandle texture = state.textures->acquire(filepath);
+    if (!texture) {
+        texture = state.textures->acquire(Sprites::Shared::PATHS[Sprites::Shared::NO_TEXTURE]);
     }
     return texture;
 }
 
 //Load textures need for minigame
 void FryingGame::loadTextures() {
-    textures["background"] = IMG_LoadTexture(state.renderer, "src/res/sprites/frying_game/background_frying.png");
-    textures["dial"] = IMG_LoadTexture(state.renderer, "src/res/sprites/frying_game/dial.png");
-    textures[ingr.name] = getIngrTexture(state.renderer, ingr);
+    textures.acquireAsync(state.textures, Sprites::FryingGame::BACKGROUND_FRYING);
+    textures.acquireAsync(state.textures, Sprites::FryingGame::DIAL);
+    ingrTexture = getIngrTexture(ingr);
 }
 
 void FryingGame::cleanup() {
-    for (auto& pair : textures) {
-        SDL_DestroyTexture(pair.second);
-    }
+    textures.reset(); //Releases our references, the cache keeps them around for a while
+    ingrTexture.reset();
+}
 
-    textures.clear();
+//Keeps the mouse in the game field and shows the square as the cursor
+void FryingGame::grabMouse()
+{
+    //The hot spot is the middle of the square, so keep it half a square in from the edges
+    SDL_FRect area = {
+        gameField.x + mouseRect.w / 2, gameField.y + mouseRect.h / 2,
+        gameField.w - mouseRect.w, gameField.h - mouseRect.h
+    };
+    confineMouse(state.window, state.renderer, &area);
+
+    if (!cursor.show(state.window, state.renderer, mouseRect.w, mouseRect.h, { 255, 10, 225, SDL_ALPHA_OPAQUE })) {
+        SDL_HideCursor(); //render() draws the square instead
+    }
 }
@@ -2,16 +2,19 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
-#include <unordered_map>
 #include <vector>
 #include "minigame.h"
 #include "../data_structs.h"
+#include "../texture_cache.h"
+#include "../asset_ids.h"
+#include "../cursor.h"
 
 class FryingGame : public Minigame { //Base your minigame off of this one
 public:
 	FryingGame(SDLState& state, CookingStep step);
 	~FryingGame();
-	void render() override;
+	void begin() override;
+	void render(float alpha) override;
 	void update() override;
 	void handleEvent(const SDL_Event& event) override;
 	bool isComplete() const override;
@@ -20,18 +23,21 @@ public:
 
 private:
 	void loadTextures();
-	SDL_Texture* getIngrTexture(SDL_Renderer* renderer, Ingredient ingr);
+	TextureHandle getIngrTexture(Ingredient ingr);
 	void cleanup();
 	void updateProgress();
 	void updateSafeZone();
 	void updateDials();
 	bool inSafeZone();
-	SDL_FRect getAspectRatioRect(SDL_Texture* texture, const SDL_FRect& targetRect);
+	void grabMouse();
+	SDL_FRect getAspectRatioRect(const TextureHandle& texture, const SDL_FRect& targetRect);
 
 	SDLState& state;
 	CookingStep step;
 	Ingredient ingr;
-	unordered_map<string, SDL_Texture*> textures;
+	SpriteSet<Sprites::FryingGame> textures;
+	TextureHandle ingrTexture; //The ingredient being prepared, from the ingredients folder
+	SolidCursor cursor; //The mouse square, drawn by the OS when the platform allows
 
 	//Members for minigame functionality
 	SDL_FRect gameField, safeZone, mouseRect, dialRectX, dialRectY;
@@ -41,6 +47,10 @@ private:
 	float progressTime;
 	double dialAngleX, dialAngleY;
 
+	//State before the last update, rendering interpolates from these
+	SDL_FRect prevSafeZone, prevProgressBar;
+	double prevDialAngleX, prevDialAngleY;
+
 	//Members for safezone logic
 	float safeZoneVX, safeZoneVY;  // Velocity components
 	float safeZoneSpeed;            // Current speed
@@ -8,7 +8,12 @@ using namespace std;
 class Minigame {
 public:
 	virtual ~Minigame() = default;
-	virtual void render() = 0;
+	// Called when the minigame goes on screen. Minigames can be built ahead of time,
+	// so timers and input grabs belong here rather than in the constructor.
+	virtual void begin() {}
+	// alpha is how far the frame is from the last update towards the next one, 0 to 1.
+	// Anything update() moves is drawn between its previous and current state by it.
+	virtual void render(float alpha) = 0;
 	virtual void update() = 0;
 	virtual void handleEvent(const SDL_Event& event) = 0;
 	virtual bool isComplete() const = 0;  // Check if minigame finished
@@ -5,11 +5,11 @@
 #include <cmath>
 #include <iostream>
 #include <string>
-#include <sstream>
-#include <iomanip>
 #include "mixing_game.h"
 #include "minigame.h"
 #include "../data_structs.h"
+#include "../string_table.h"
+#include "../clock.h"
 
 using namespace std;
 
@@ -31,14 +31,17 @@ MixingGame::MixingGame(SDLState& state, CookingStep step)
     lastAngle(0.0f),
     progress(0.0f),
     trackingCircle(false),
-    startTicks(SDL_GetTicks()),
+    startTicks(state.clock->nowMS()),
     completionTicks(0),
     score(0)
 {
     loadTextures();
+    if (state.strings) {
+        state.strings->prepare(StringId::MixInstructions, state.font);
+    }
 
-    if (textures[ingr.name]) {
-        ingredientRect = getAspectRatioRect(textures[ingr.name], {
+    if (ingrTexture) {
+        ingredientRect = getAspectRatioRect(ingrTexture, {
             bowlCenter.x - bowlRadius * 0.8f,
             bowlCenter.y - bowlRadius * 0.6f,
             bowlRadius * 1.6f,
@@ -50,26 +53,31 @@ MixingGame::MixingGame(SDLState& state, CookingStep step)
     }
 }
 
+void MixingGame::begin()
+{
+    startTicks = state.clock->nowMS(); //The time limit counts from when the player sees the bowl
+}
+
 MixingGame::~MixingGame()
 {
     cleanup();
 }
 
-void MixingGame::render()
+void MixingGame::render(float /*alpha*/) //Progress only changes on mouse events, nothing to interpolate
 {
     SDL_Renderer* renderer = state.renderer;
 
-    if (textures["background"]) {
-        SDL_RenderTexture(renderer, textures["background"], nullptr, nullptr);
+    if (textures[Sprites::MixingGame::BACKGROUND_MIXING]) {
+        textures[Sprites::MixingGame::BACKGROUND_MIXING].render(renderer, nullptr, nullptr);
     }
 
-    if (textures[ingr.name]) {
-        SDL_RenderTexture(renderer, textures[ingr.name], nullptr, &ingredientRect);
+    if (ingrTexture) {
+        ingrTexture.render(renderer, nullptr, &ingredientRect);
     }
 
-    SDL_FRect bowlTextureRect = getAspectRatioRect(textures["bowl"], bowlRect);
-    if (textures["bowl"]) {
-        SDL_RenderTexture(renderer, textures["bowl"], nullptr, &bowlTextureRect);
+    SDL_FRect bowlTextureRect = getAspectRatioRect(textures[Sprites::MixingGame::BOWL], bowlRect);
+    if (textures[Sprites::MixingGame::BOWL]) {
+        textures[Sprites::MixingGame::BOWL].render(renderer, nullptr, &bowlTextureRect);
     } else {
         SDL_SetRenderDrawColor(renderer, 200, 220, 255, SDL_ALPHA_OPAQUE);
         SDL_RenderRect(renderer, &bowlTextureRect);
@@ -92,82 +100,27 @@ void MixingGame::render()
     SDL_SetRenderDrawColor(renderer, 130, 170, 255, SDL_ALPHA_OPAQUE);
     SDL_RenderFillRect(renderer, &progressBar);
 
-    if (state.font) {
-        Uint64 nowTicks = completionTicks != 0 ? completionTicks : SDL_GetTicks();
+    if (state.font && state.strings) {
+        Uint64 nowTicks = completionTicks != 0 ? completionTicks : state.clock->nowMS();
         float elapsedSeconds = static_cast<float>(nowTicks - startTicks) / 1000.0f;
         float remainingSeconds = max(0.0f, SCORE_TIME_LIMIT - elapsedSeconds);
 
-        ostringstream timerStream;
-        timerStream << fixed << setprecision(1) << remainingSeconds;
-        string timerText = "Time left: " + timerStream.str() + "s";
+        char timerText[64];
+        SDL_snprintf(timerText, sizeof(timerText), state.strings->get(StringId::TimeLeftFmt), remainingSeconds);
 
         int percent = step.duration > 0 ? (int)round((progress / step.duration) * 100.0f) : 100;
         percent = max(0, min(100, percent));
-        string text = "Mix progress: " + to_string(percent) + "%";
+        char text[64];
+        SDL_snprintf(text, sizeof(text), state.strings->get(StringId::MixProgressFmt), percent);
         SDL_Color textColor = { 0, 0, 0, SDL_ALPHA_OPAQUE };
-        SDL_Surface* textSurface = TTF_RenderText_Solid(state.font, text.c_str(), 0, textColor);
-        if (textSurface) {
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-            if (textTexture) {
-                float textW, textH;
-                SDL_GetTextureSize(textTexture, &textW, &textH);
-
-                SDL_FRect textRect = {
-                    progressBarBG.x + (progressBarBG.w - textW) / 2,
-                    progressBarBG.y - textH - 6,
-                    textW,
-                    textH
-                };
-
-                SDL_RenderTexture(renderer, textTexture, nullptr, &textRect);
-                SDL_DestroyTexture(textTexture);
-            }
-            SDL_DestroySurface(textSurface);
-        }
 
-        SDL_Surface* timerSurface = TTF_RenderText_Solid(state.font, timerText.c_str(), 0, textColor);
-        if (timerSurface) {
-            SDL_Texture* timerTexture = SDL_CreateTextureFromSurface(renderer, timerSurface);
-
-            if (timerTexture) {
-                float textW, textH;
-                SDL_GetTextureSize(timerTexture, &textW, &textH);
-
-                SDL_FRect timerRect = {
-                    progressBarBG.x + (progressBarBG.w - textW) / 2,
-                    progressBarBG.y + progressBarBG.h + 6,
-                    textW,
-                    textH
-                };
-
-                SDL_RenderTexture(renderer, timerTexture, nullptr, &timerRect);
-                SDL_DestroyTexture(timerTexture);
-            }
-            SDL_DestroySurface(timerSurface);
-        }
+        progressLabel.setText(state.text, state.font, text, textColor);
+        progressLabel.render(progressBarBG.x + progressBarBG.w / 2, progressBarBG.y - 6, 0.5f, 1.0f);
 
-        string instruct = "Circle the bowl or press Spacebar to mix!";
-        SDL_Surface* instructSurface = TTF_RenderText_Solid(state.font, instruct.c_str(), 0, textColor);
-        if (instructSurface) {
-            SDL_Texture* instructTexture = SDL_CreateTextureFromSurface(renderer, instructSurface);
+        timerLabel.setText(state.text, state.font, timerText, textColor);
+        timerLabel.render(progressBarBG.x + progressBarBG.w / 2, progressBarBG.y + progressBarBG.h + 6, 0.5f, 0.0f);
 
-            if (instructTexture) {
-                float textW, textH;
-                SDL_GetTextureSize(instructTexture, &textW, &textH);
-
-                SDL_FRect textRect = {
-                    bowlRect.x + (bowlRect.w - textW) / 2,
-                    bowlRect.y + bowlRect.h + 10,
-                    textW,
-                    textH
-                };
-
-                SDL_RenderTexture(renderer, instructTexture, nullptr, &textRect);
-                SDL_DestroyTexture(instructTexture);
-            }
-            SDL_DestroySurface(instructSurface);
-        }
+        state.strings->draw(StringId::MixInstructions, state.font, bowlRect.x + bowlRect.w / 2, bowlRect.y + bowlRect.h + 10, textColor, 0.5f, 0.0f);
     }
 }
 
@@ -245,28 +198,23 @@ void MixingGame::updateProgress()
     progressBar.h = progressBarBG.h - 10;
 }
 
-SDL_Texture* MixingGame::getIngrTexture(SDL_Renderer* renderer, Ingredient ingr) {
+TextureHandle MixingGame::getIngrTexture(Ingredient ingr) {
     string filepath = "src/res/sprites/ingredients/" + ingr.name + ".png";
-    SDL_Texture* texture;
-    try {
-        texture = IMG_LoadTexture(renderer, filepath.c_str());
-    }
-    catch (int e) {
-        cout << "Error loading texture: " << e;
-        texture = IMG_LoadTexture(renderer, "src/res/sprites/no_texture.png");
+    TextureHandle texture = state.textures->acquire(filepath);
+    if (!texture) {
+        texture = state.textures->acquire(Sprites::Shared::PATHS[Sprites::Shared::NO_TEXTURE]);
     }
     return texture;
 }
 
-SDL_FRect MixingGame::getAspectRatioRect(SDL_Texture* texture, const SDL_FRect& targetRect)
+SDL_FRect MixingGame::getAspectRatioRect(const TextureHandle& texture, const SDL_FRect& targetRect)
 {
-    if (!texture) {
+    float textureWidth = texture.getWidth();
+    float textureHeight = texture.getHeight();
+    if (textureWidth <= 0.0f || textureHeight <= 0.0f) {
         return targetRect;
     }
 
-    float textureWidth, textureHeight;
-    SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
-
     float textureAspect = textureWidth / textureHeight;
     float targetAspect = targetRect.w / targetRect.h;
 
@@ -305,17 +253,14 @@ void MixingGame::applyStir(float amount)
 }
 
 void MixingGame::loadTextures() {
-    textures["background"] = IMG_LoadTexture(state.renderer, "src/res/sprites/mixing_game/background_mixing.png");
-    textures["bowl"] = IMG_LoadTexture(state.renderer, "src/res/sprites/mixing_game/bowl.png");
-    textures[ingr.name] = getIngrTexture(state.renderer, ingr);
+    textures.acquireAsync(state.textures, Sprites::MixingGame::BACKGROUND_MIXING);
+    textures.acquireAsync(state.textures, Sprites::MixingGame::BOWL);
+    ingrTexture = getIngrTexture(ingr);
 }
 
 void MixingGame::cleanup() {
-    for (auto& pair : textures) {
-        SDL_DestroyTexture(pair.second);
-    }
-
-    textures.clear();
+    textures.reset(); //Releases our references, the cache keeps them around for a while
+    ingrTexture.reset();
 }
 
 void MixingGame::finalizeScoreIfComplete()
@@ -324,7 +269,7 @@ void MixingGame::finalizeScoreIfComplete()
         return;
     }
 
-    completionTicks = SDL_GetTicks();
+    completionTicks = state.clock->nowMS();
     float elapsedSeconds = getElapsedSeconds();
     float clampedTime = min(elapsedSeconds, SCORE_TIME_LIMIT);
     float remaining = max(0.0f, SCORE_TIME_LIMIT - clampedTime);
@@ -339,7 +284,7 @@ int MixingGame::getScore() const
 
 float MixingGame::getElapsedSeconds() const
 {
-    Uint64 nowTicks = completionTicks != 0 ? completionTicks : SDL_GetTicks();
+    Uint64 nowTicks = completionTicks != 0 ? completionTicks : state.clock->nowMS();
     return static_cast<float>(nowTicks - startTicks) / 1000.0f;
 }
 
@@ -2,17 +2,20 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
-#include <unordered_map>
 #include <string>
 #include <vector>
 #include "minigame.h"
 #include "../data_structs.h"
+#include "../texture_cache.h"
+#include "../asset_ids.h"
+#include "../text_label.h"
 
 class MixingGame : public Minigame { //Base your minigame off of this one
 public:
 	MixingGame(SDLState& state, CookingStep step);
 	~MixingGame();
-	void render() override;
+	void begin() override;
+	void render(float alpha) override;
 	void update() override;
 	void handleEvent(const SDL_Event& event) override;
 	bool isComplete() const override;
@@ -20,8 +23,8 @@ public:
 
 private:
 	void loadTextures();
-	SDL_Texture* getIngrTexture(SDL_Renderer* renderer, Ingredient ingr);
-	SDL_FRect getAspectRatioRect(SDL_Texture* texture, const SDL_FRect& targetRect);
+	TextureHandle getIngrTexture(Ingredient ingr);
+	SDL_FRect getAspectRatioRect(const TextureHandle& texture, const SDL_FRect& targetRect);
 	bool isInBowl(float x, float y) const;
 	void applyStir(float amount);
 	void cleanup();
@@ -33,7 +36,8 @@ private:
 	SDLState& state;
 	const CookingStep step;
 	Ingredient ingr;
-	unordered_map<string, SDL_Texture*> textures;
+	SpriteSet<Sprites::MixingGame> textures;
+	TextureHandle ingrTexture; //The ingredient being prepared, from the ingredients folder
 	SDL_FRect bowlRect;
 	SDL_FRect ingredientRect;
 	SDL_FRect progressBarBG;
@@ -46,4 +50,8 @@ private:
 	Uint64 startTicks;
 	Uint64 completionTicks;
 	int score;
+
+	//HUD text, only re-laid out when the shown value changes
+	TextLabel progressLabel;
+	TextLabel timerLabel;
 };
@@ -0,0 +1,755 @@
+#include "png_decoder.h"
+#include <SDL3_image/SDL_image.h>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PNG_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define PNG_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace {
+    atomic<ImageDecoder> currentDecoder{ ImageDecoder::SDLImage };
+    atomic<SDL_PixelFormat> decodeFormat{ SDL_PIXELFORMAT_ABGR8888 };
+
+    // -------- Inflate --------
+
+    const int FAST_BITS = 10;    // codes up to this long are decoded with one table lookup
+    const size_t COPY_SLACK = 16; // matches are copied 8 bytes at a time and may write past the end
+
+    const Uint16 LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    const Uint8 LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    const Uint16 DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    const Uint8 DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    const Uint8 CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    Uint32 reverse16(Uint32 n)
+    {
+        n = ((n & 0xAAAA) >> 1) | ((n & 0x5555) << 1);
+        n = ((n & 0xCCCC) >> 2) | ((n & 0x3333) << 2);
+        n = ((n & 0xF0F0) >> 4) | ((n & 0x0F0F) << 4);
+        n = ((n & 0xFF00) >> 8) | ((n & 0x00FF) << 8);
+        return n;
+    }
+
+    // Canonical Huffman code. Deflate sends codes most significant bit first inside a
+    // little endian bit stream, so the fast table is indexed by the bit reversed code.
+    struct Huffman {
+        Uint16 fast[1 << FAST_BITS]; // length << 9 | symbol, 0 when the code is longer than FAST_BITS
+        Uint16 firstCode[16];
+        Uint16 firstSymbol[16];
+        Uint32 maxCode[17];          // first code past each length, left aligned to 16 bits
+        Uint8 sizes[288];
+        Uint16 values[288];
+
+        bool build(const Uint8* lengths, int count)
+        {
+            int counts[16] = {};
+            for (int i = 0; i < count; i++) counts[lengths[i]]++;
+            counts[0] = 0;
+
+            SDL_memset(fast, 0, sizeof(fast));
+            int nextCode[16];
+            int code = 0;
+            int symbol = 0;
+            for (int i = 1; i < 16; i++) {
+                nextCode[i] = code;
+                firstCode[i] = static_cast<Uint16>(code);
+                firstSymbol[i] = static_cast<Uint16>(symbol);
+                code += counts[i];
+                if (counts[i] && code - 1 >= (1 << i)) return false; //Oversubscribed
+                maxCode[i] = code << (16 - i);
+                code <<= 1;
+                symbol += counts[i];
+            }
+            maxCode[16] = 0x10000;
+
+            for (int i = 0; i < count; i++) {
+                int length = lengths[i];
+                if (!length) continue;
+                int slot = nextCode[length] - firstCode[length] + firstSymbol[length];
+                sizes[slot] = static_cast<Uint8>(length);
+                values[slot] = static_cast<Uint16>(i);
+                if (length <= FAST_BITS) {
+                    int reversed = reverse16(nextCode[length]) >> (16 - length);
+                    for (int j = reversed; j < (1 << FAST_BITS); j += 1 << length) {
+                        fast[j] = static_cast<Uint16>(length << 9 | i);
+                    }
+                }
+                nextCode[length]++;
+            }
+            return true;
+        }
+    };
+
+    // Keeps at least 56 bits buffered, refilling 8 bytes at a time away from the end of the data
+    struct BitReader {
+        const Uint8* data;
+        size_t size;
+        size_t pos = 0; // bytes moved into bits so far
+        Uint64 bits = 0;
+        int count = 0;
+
+        void refill()
+        {
+            if (pos + 8 <= size) {
+                Uint64 word;
+                SDL_memcpy(&word, data + pos, sizeof(word));
+                bits |= SDL_Swap64LE(word) << count;
+                pos += (63 - count) >> 3;
+                count |= 56;
+            }
+            else {
+                while (count <= 56) { //Zeros past the end, overrunning is caught by the caller
+                    Uint64 byte = pos < size ? data[pos] : 0;
+                    bits |= byte << count;
+                    pos++;
+                    count += 8;
+                }
+            }
+        }
+
+        Uint32 take(int n)
+        {
+            Uint32 value = static_cast<Uint32>(bits & ((Uint64(1) << n) - 1));
+            bits >>= n;
+            count -= n;
+            return value;
+        }
+
+        //Byte position of the next unread bit once aligned, undoing the read ahead
+        size_t alignToByte()
+        {
+            take(count & 7);
+            size_t next = pos - count / 8;
+            pos = next;
+            bits = 0;
+            count = 0;
+            return next;
+        }
+    };
+
+    class Inflater {
+    public:
+        Inflater(const Uint8* data, size_t size, Uint8* out, size_t outSize)
+            : in{ data, size }, out(out), outStart(out), outEnd(out + outSize) {}
+
+        bool run()
+        {
+            bool final = false;
+            while (!final) {
+                in.refill();
+                final = in.take(1) != 0;
+                int type = in.take(2);
+                bool ok = false;
+                if (type == 0) ok = stored();
+                else if (type == 1) ok = fixed();
+                else if (type == 2) ok = dynamic();
+                if (!ok) return false;
+            }
+            return out == outEnd && in.pos - in.count / 8 <= in.size;
+        }
+
+    private:
+        int decode(const Huffman& h)
+        {
+            int entry = h.fast[in.bits & ((1 << FAST_BITS) - 1)];
+            if (entry) {
+                in.take(entry >> 9);
+                return entry & 511;
+            }
+
+            Uint32 code = reverse16(static_cast<Uint32>(in.bits & 0xFFFF));
+            int length = FAST_BITS + 1;
+            while (length < 16 && code >= h.maxCode[length]) length++;
+            if (length == 16) return -1;
+
+            int slot = (code >> (16 - length)) - h.firstCode[length] + h.firstSymbol[length];
+            if (slot < 0 || slot >= 288 || h.sizes[slot] != length) return -1;
+            in.take(length);
+            return h.values[slot];
+        }
+
+        bool stored()
+        {
+            size_t pos = in.alignToByte();
+            if (pos + 4 > in.size) return false;
+            Uint32 length = in.data[pos] | in.data[pos + 1] << 8;
+            Uint32 inverse = in.data[pos + 2] | in.data[pos + 3] << 8;
+            pos += 4;
+            if ((length ^ 0xFFFF) != inverse || length > in.size - pos || length > static_cast<size_t>(outEnd - out)) return false;
+
+            SDL_memcpy(out, in.data + pos, length);
+            out += length;
+            in.pos = pos + length;
+            return true;
+        }
+
+        bool fixed()
+        {
+            Uint8 lengths[288 + 30];
+            SDL_memset(lengths, 8, 144);
+            SDL_memset(lengths + 144, 9, 112);
+            SDL_memset(lengths + 256, 7, 24);
+            SDL_memset(lengths + 280, 8, 8);
+            SDL_memset(lengths + 288, 5, 30);
+            return literals.build(lengths, 288) && distances.build(lengths + 288, 30) && codes();
+        }
+
+        bool dynamic()
+        {
+            in.refill();
+            int literalCount = in.take(5) + 257;
+            int distanceCount = in.take(5) + 1;
+            int codeLengthCount = in.take(4) + 4;
+            if (literalCount > 286 || distanceCount > 30) return false;
+
+            Uint8 codeLengths[19] = {};
+            for (int i = 0; i < codeLengthCount; i++) {
+                in.refill();
+                codeLengths[CODE_LENGTH_ORDER[i]] = static_cast<Uint8>(in.take(3));
+            }
+            Huffman codeLengthCode;
+            if (!codeLengthCode.build(codeLengths, 19)) return false;
+
+            Uint8 lengths[286 + 30];
+            int total = literalCount + distanceCount;
+            int n = 0;
+            while (n < total) {
+                in.refill();
+                int symbol = decode(codeLengthCode);
+                if (symbol < 0) return false;
+                if (symbol < 16) {
+                    lengths[n++] = static_cast<Uint8>(symbol);
+                    continue;
+                }
+
+                Uint8 fill = 0;
+                int repeat;
+                if (symbol == 16) {
+                    if (n == 0) return false;
+                    fill = lengths[n - 1];
+                    repeat = 3 + in.take(2);
+                }
+                else if (symbol == 17) {
+                    repeat = 3 + in.take(3);
+                }
+                else {
+                    repeat = 11 + in.take(7);
+                }
+                if (n + repeat > total) return false;
+                SDL_memset(lengths + n, fill, repeat);
+                n += repeat;
+            }
+            if (lengths[256] == 0) return false; //No end of block code
+
+            return literals.build(lengths, literalCount) && distances.build(lengths + literalCount, distanceCount) && codes();
+        }
+
+        bool codes()
+        {
+            for (;;) {
+                //56 bits cover the longest length code, its extra bits, distance code and extra bits
+                in.refill();
+                int symbol = decode(literals);
+                if (symbol < 256) {
+                    if (symbol < 0 || out == outEnd) return false;
+                    *out++ = static_cast<Uint8>(symbol);
+                    continue;
+                }
+                if (symbol == 256) return true;
+
+                symbol -= 257;
+                if (symbol >= 29) return false;
+                size_t length = LENGTH_BASE[symbol] + in.take(LENGTH_EXTRA[symbol]);
+                int distanceSymbol = decode(distances);
+                if (distanceSymbol < 0 || distanceSymbol >= 30) return false;
+                size_t distance = DIST_BASE[distanceSymbol] + in.take(DIST_EXTRA[distanceSymbol]);
+                if (distance > static_cast<size_t>(out - outStart) || length > static_cast<size_t>(outEnd - out)) return false;
+
+                const Uint8* source = out - distance;
+                if (distance >= 8) { //Whole words, overshooting into the slack past outEnd
+                    for (size_t i = 0; i < length; i += 8) {
+                        SDL_memcpy(out + i, source + i, 8);
+                    }
+                }
+                else if (distance == 1) { //Runs of one byte, common in flat areas of sprites
+                    SDL_memset(out, *source, length);
+                }
+                else {
+                    for (size_t i = 0; i < length; i++) {
+                        out[i] = source[i];
+                    }
+                }
+                out += length;
+            }
+        }
+
+        BitReader in;
+        Uint8* out;
+        Uint8* outStart;
+        Uint8* outEnd;
+        Huffman literals;
+        Huffman distances;
+    };
+
+    bool inflateZlib(const Uint8* data, size_t size, Uint8* out, size_t outSize)
+    {
+        if (size < 2) return false;
+        int method = data[0];
+        int flags = data[1];
+        if ((method & 15) != 8 || (method >> 4) > 7 || (method << 8 | flags) % 31 != 0 || (flags & 0x20)) return false;
+
+        Inflater inflater(data + 2, size - 2, out, outSize);
+        return inflater.run();
+    }
+
+    // -------- Unfiltering --------
+
+    //Scalar version of every filter, used for 1 and 2 byte pixels and without SIMD
+    bool unfilterScalar(int filter, Uint8* row, const Uint8* prior, size_t rowBytes, int bpp)
+    {
+        switch (filter) {
+        case 0:
+            return true;
+        case 1:
+            for (size_t i = bpp; i < rowBytes; i++) row[i] += row[i - bpp];
+            return true;
+        case 2:
+            for (size_t i = 0; i < rowBytes; i++) row[i] += prior[i];
+            return true;
+        case 3:
+            for (int i = 0; i < bpp; i++) row[i] += prior[i] >> 1;
+            for (size_t i = bpp; i < rowBytes; i++) row[i] += (row[i - bpp] + prior[i]) >> 1;
+            return true;
+        case 4:
+            for (int i = 0; i < bpp; i++) row[i] += prior[i];
+            for (size_t i = bpp; i < rowBytes; i++) {
+                int a = row[i - bpp], b = prior[i], c = prior[i - bpp];
+                int pa = SDL_abs(b - c), pb = SDL_abs(a - c), pc = SDL_abs(a + b - 2 * c);
+                row[i] += (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    //Sub, Average and Paeth depend on the pixel to the left, so the vectors hold one pixel
+    //and run across its channels, as libpng does
+#if defined(PNG_SSE2)
+    template <int BPP>
+    __m128i loadPixel(const Uint8* p)
+    {
+        Uint32 value = 0;
+        SDL_memcpy(&value, p, BPP);
+        return _mm_cvtsi32_si128(static_cast<int>(value));
+    }
+
+    template <int BPP>
+    void storePixel(Uint8* p, __m128i v)
+    {
+        Uint32 value = static_cast<Uint32>(_mm_cvtsi128_si32(v));
+        SDL_memcpy(p, &value, BPP);
+    }
+
+    __m128i abs16(__m128i x)
+    {
+        return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+    }
+
+    __m128i select(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    template <int BPP>
+    void unfilterSub(Uint8* row, size_t rowBytes)
+    {
+        __m128i a = _mm_setzero_si128();
+        for (size_t i = 0; i < rowBytes; i += BPP) {
+            a = _mm_add_epi8(a, loadPixel<BPP>(row + i));
+            storePixel<BPP>(row + i, a);
+        }
+    }
+
+    template <int BPP>
+    void unfilterAverage(Uint8* row, const Uint8* prior, size_t rowBytes)
+    {
+        //_mm_avg_epu8 rounds up, the filter rounds down
+        const __m128i ones = _mm_set1_epi8(1);
+        __m128i a = _mm_setzero_si128();
+        for (size_t i = 0; i < rowBytes; i += BPP) {
+            __m128i b = loadPixel<BPP>(prior + i);
+            __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), ones));
+            a = _mm_add_epi8(loadPixel<BPP>(row + i), average);
+            storePixel<BPP>(row + i, a);
+        }
+    }
+
+    template <int BPP>
+    void unfilterPaeth(Uint8* row, const Uint8* prior, size_t rowBytes)
+    {
+        //Widened to 16 bits, pa = |b - c|, pb = |a - c|, pc = |a + b - 2c|
+        const __m128i zero = _mm_setzero_si128();
+        __m128i a = zero, c = zero;
+        for (size_t i = 0; i < rowBytes; i += BPP) {
+            __m128i b = _mm_unpacklo_epi8(loadPixel<BPP>(prior + i), zero);
+            __m128i pa = _mm_sub_epi16(b, c);
+            __m128i pb = _mm_sub_epi16(a, c);
+            __m128i pc = abs16(_mm_add_epi16(pa, pb));
+            pa = abs16(pa);
+            pb = abs16(pb);
+
+            __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            __m128i predictor = select(_mm_cmpeq_epi16(smallest, pa), a, select(_mm_cmpeq_epi16(smallest, pb), b, c));
+            __m128i pixel = _mm_add_epi8(loadPixel<BPP>(row + i), _mm_packus_epi16(predictor, predictor));
+            storePixel<BPP>(row + i, pixel);
+
+            a = _mm_unpacklo_epi8(pixel, zero);
+            c = b;
+        }
+    }
+#elif defined(PNG_NEON)
+    template <int BPP>
+    uint8x8_t loadPixel(const Uint8* p)
+    {
+        Uint32 value = 0;
+        SDL_memcpy(&value, p, BPP);
+        return vreinterpret_u8_u32(vdup_n_u32(value));
+    }
+
+    template <int BPP>
+    void storePixel(Uint8* p, uint8x8_t v)
+    {
+        Uint32 value = vget_lane_u32(vreinterpret_u32_u8(v), 0);
+        SDL_memcpy(p, &value, BPP);
+    }
+
+    template <int BPP>
+    void unfilterSub(Uint8* row, size_t rowBytes)
+    {
+        uint8x8_t a = vdup_n_u8(0);
+        for (size_t i = 0; i < rowBytes; i += BPP) {
+            a = vadd_u8(a, loadPixel<BPP>(row + i));
+            storePixel<BPP>(row + i, a);
+        }
+    }
+
+    template <int BPP>
+    void unfilterAverage(Uint8* row, const Uint8* prior, size_t rowBytes)
+    {
+        uint8x8_t a = vdup_n_u8(0);
+        for (size_t i = 0; i < rowBytes; i += BPP) {
+            a = vadd_u8(loadPixel<BPP>(row + i), vhadd_u8(a, loadPixel<BPP>(prior + i)));
+            storePixel<BPP>(row + i, a);
+        }
+    }
+
+    template <int BPP>
+    void unfilterPaeth(Uint8* row, const Uint8* prior, size_t rowBytes)
+    {
+        uint8x8_t a = vdup_n_u8(0), c = a;
+        for (size_t i = 0; i < rowBytes; i += BPP) {
+            uint8x8_t b = loadPixel<BPP>(prior + i);
+            uint16x8_t pa = vabdl_u8(b, c);
+            uint16x8_t pb = vabdl_u8(a, c);
+            uint16x8_t pc = vabdq_u16(vaddl_u8(a, b), vshll_n_u8(c, 1));
+
+            uint8x8_t useA = vmovn_u16(vandq_u16(vcleq_u16(pa, pb), vcleq_u16(pa, pc)));
+            uint8x8_t useB = vmovn_u16(vcleq_u16(pb, pc));
+            uint8x8_t predictor = vbsl_u8(useA, a, vbsl_u8(useB, b, c));
+            a = vadd_u8(loadPixel<BPP>(row + i), predictor);
+            storePixel<BPP>(row + i, a);
+            c = b;
+        }
+    }
+#endif
+
+    bool unfilterRow(int filter, Uint8* row, const Uint8* prior, size_t rowBytes, int bpp)
+    {
+#if defined(PNG_SSE2) || defined(PNG_NEON)
+        if (bpp == 3 || bpp == 4) {
+            bool rgba = bpp == 4;
+            switch (filter) {
+            case 1:
+                rgba ? unfilterSub<4>(row, rowBytes) : unfilterSub<3>(row, rowBytes);
+                return true;
+            case 3:
+                rgba ? unfilterAverage<4>(row, prior, rowBytes) : unfilterAverage<3>(row, prior, rowBytes);
+                return true;
+            case 4:
+                rgba ? unfilterPaeth<4>(row, prior, rowBytes) : unfilterPaeth<3>(row, prior, rowBytes);
+                return true;
+            }
+        }
+#endif
+        //None, and Up which compilers vectorize on their own
+        return unfilterScalar(filter, row, prior, rowBytes, bpp);
+    }
+
+    // -------- Output --------
+
+    struct PngInfo {
+        Uint32 width = 0;
+        Uint32 height = 0;
+        int colorType = -1;
+        int channels = 0;
+        Uint8 palette[256][4];  // RGBA, alpha from tRNS
+        bool hasKey = false;    // tRNS color that is fully transparent, for grey and RGB images
+        Uint8 key[3] = {};
+    };
+
+    template <bool ARGB>
+    Uint32 packPixel(Uint32 r, Uint32 g, Uint32 b, Uint32 a)
+    {
+        return ARGB ? (a << 24 | r << 16 | g << 8 | b) : (a << 24 | b << 16 | g << 8 | r);
+    }
+
+    template <bool ARGB>
+    void convertRow(const PngInfo& png, const Uint8* src, Uint32* dst)
+    {
+        Uint32 width = png.width;
+        switch (png.colorType) {
+        case 6: //RGBA
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            if (!ARGB) { //Already in memory order
+                SDL_memcpy(dst, src, width * 4);
+                return;
+            }
+            for (Uint32 x = 0; x < width; x++) { //Swaps red and blue, compilers vectorize this
+                Uint32 p;
+                SDL_memcpy(&p, src + x * 4, 4);
+                dst[x] = (p & 0xFF00FF00) | (p & 0xFF) << 16 | (p >> 16 & 0xFF);
+            }
+#else
+            for (Uint32 x = 0; x < width; x++, src += 4) {
+                dst[x] = packPixel<ARGB>(src[0], src[1], src[2], src[3]);
+            }
+#endif
+            return;
+        case 2: //RGB
+            for (Uint32 x = 0; x < width; x++, src += 3) {
+                bool keyed = png.hasKey && src[0] == png.key[0] && src[1] == png.key[1] && src[2] == png.key[2];
+                dst[x] = packPixel<ARGB>(src[0], src[1], src[2], keyed ? 0 : 255);
+            }
+            return;
+        case 0: //Grey
+            for (Uint32 x = 0; x < width; x++) {
+                bool keyed = png.hasKey && src[x] == png.key[0];
+                dst[x] = packPixel<ARGB>(src[x], src[x], src[x], keyed ? 0 : 255);
+            }
+            return;
+        case 4: //Grey and alpha
+            for (Uint32 x = 0; x < width; x++, src += 2) {
+                dst[x] = packPixel<ARGB>(src[0], src[0], src[0], src[1]);
+            }
+            return;
+        case 3: { //Palette
+            Uint32 colors[256];
+            for (int i = 0; i < 256; i++) {
+                colors[i] = packPixel<ARGB>(png.palette[i][0], png.palette[i][1], png.palette[i][2], png.palette[i][3]);
+            }
+            for (Uint32 x = 0; x < width; x++) {
+                dst[x] = colors[src[x]];
+            }
+            return;
+        }
+        }
+    }
+
+    Uint32 readBE32(const Uint8* p)
+    {
+        return static_cast<Uint32>(p[0]) << 24 | p[1] << 16 | p[2] << 8 | p[3];
+    }
+}
+
+SDL_Surface* decodePng(const void* data, size_t size, SDL_PixelFormat format)
+{
+    static const Uint8 SIGNATURE[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    if (format != SDL_PIXELFORMAT_ARGB8888 && format != SDL_PIXELFORMAT_ABGR8888) return nullptr;
+    if (size < sizeof(SIGNATURE) || SDL_memcmp(bytes, SIGNATURE, sizeof(SIGNATURE)) != 0) return nullptr;
+
+    PngInfo png;
+    for (int i = 0; i < 256; i++) { //Indices past the palette come out opaque black
+        png.palette[i][0] = png.palette[i][1] = png.palette[i][2] = 0;
+        png.palette[i][3] = 255;
+    }
+
+    //The image data is usually one IDAT chunk, only split ones are joined into a copy
+    const Uint8* compressed = nullptr;
+    size_t compressedSize = 0;
+    vector<Uint8> joined;
+
+    size_t pos = sizeof(SIGNATURE);
+    while (pos + 12 <= size) {
+        Uint32 length = readBE32(bytes + pos);
+        const Uint8* type = bytes + pos + 4;
+        const Uint8* chunk = bytes + pos + 8;
+        if (length > size - pos - 12) return nullptr;
+        pos += 12 + static_cast<size_t>(length);
+
+        if (SDL_memcmp(type, "IHDR", 4) == 0) {
+            if (length < 13) return nullptr;
+            png.width = readBE32(chunk);
+            png.height = readBE32(chunk + 4);
+            int depth = chunk[8];
+            png.colorType = chunk[9];
+            bool interlaced = chunk[12] != 0;
+            if (depth != 8 || interlaced || chunk[10] != 0 || chunk[11] != 0) return nullptr;
+
+            static const int CHANNELS[7] = { 1, 0, 3, 1, 2, 0, 4 };
+            png.channels = png.colorType <= 6 ? CHANNELS[png.colorType] : 0;
+            if (png.channels == 0) return nullptr;
+        }
+        else if (SDL_memcmp(type, "PLTE", 4) == 0) {
+            if (length % 3 != 0 || length > 768) return nullptr;
+            for (Uint32 i = 0; i < length / 3; i++) {
+                png.palette[i][0] = chunk[i * 3];
+                png.palette[i][1] = chunk[i * 3 + 1];
+                png.palette[i][2] = chunk[i * 3 + 2];
+            }
+        }
+        else if (SDL_memcmp(type, "tRNS", 4) == 0) {
+            if (png.colorType == 3) {
+                for (Uint32 i = 0; i < length && i < 256; i++) {
+                    png.palette[i][3] = chunk[i];
+                }
+            }
+            else if (png.colorType == 0 && length >= 2) {
+                png.hasKey = chunk[0] == 0;
+                png.key[0] = chunk[1];
+            }
+            else if (png.colorType == 2 && length >= 6) {
+                png.hasKey = chunk[0] == 0 && chunk[2] == 0 && chunk[4] == 0;
+                png.key[0] = chunk[1];
+                png.key[1] = chunk[3];
+                png.key[2] = chunk[5];
+            }
+        }
+        else if (SDL_memcmp(type, "IDAT", 4) == 0) {
+            if (!compressed) {
+                compressed = chunk;
+                compressedSize = length;
+            }
+            else {
+                if (joined.empty()) joined.assign(compressed, compressed + compressedSize);
+                joined.insert(joined.end(), chunk, chunk + length);
+                compressed = joined.data();
+                compressedSize = joined.size();
+            }
+        }
+        else if (SDL_memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+    }
+    if (png.channels == 0 || png.width == 0 || png.height == 0 || !compressed) return nullptr;
+    if (png.width > 32768 || png.height > 32768) return nullptr;
+
+    //Inflate everything at once, each row is its filter type byte followed by the pixels
+    size_t rowBytes = static_cast<size_t>(png.width) * png.channels;
+    size_t filteredSize = (rowBytes + 1) * png.height;
+    unique_ptr<Uint8[]> filtered(new (nothrow) Uint8[filteredSize + COPY_SLACK]);
+    if (!filtered || !inflateZlib(compressed, compressedSize, filtered.get(), filteredSize)) return nullptr;
+
+    SDL_Surface* surface = SDL_CreateSurface(png.width, png.height, format);
+    if (!surface) return nullptr;
+
+    //Each row is converted right after unfiltering, while it is still in cache
+    vector<Uint8> zeroRow(rowBytes, 0);
+    const Uint8* prior = zeroRow.data();
+    for (Uint32 y = 0; y < png.height; y++) {
+        Uint8* row = filtered.get() + y * (rowBytes + 1);
+        if (!unfilterRow(row[0], row + 1, prior, rowBytes, png.channels)) {
+            SDL_DestroySurface(surface);
+            return nullptr;
+        }
+
+        Uint32* dst = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+        if (format == SDL_PIXELFORMAT_ARGB8888) {
+            convertRow<true>(png, row + 1, dst);
+        }
+        else {
+            convertRow<false>(png, row + 1, dst);
+        }
+        prior = row + 1;
+    }
+    return surface;
+}
+
+void initImageDecoder(SDL_Renderer* renderer, ImageDecoder fallback)
+{
+    //Renderers list the formats they take in order of preference
+    const SDL_PixelFormat* formats = static_cast<const SDL_PixelFormat*>(SDL_GetPointerProperty(
+        SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr));
+    for (; formats && *formats != SDL_PIXELFORMAT_UNKNOWN; formats++) {
+        if (*formats == SDL_PIXELFORMAT_ARGB8888 || *formats == SDL_PIXELFORMAT_ABGR8888) {
+            decodeFormat = *formats;
+            break;
+        }
+    }
+
+    ImageDecoder decoder = fallback;
+    if (const char* name = SDL_getenv("PNG_DECODER")) {
+        if (SDL_strcasecmp(name, "sdl") == 0) {
+            decoder = ImageDecoder::SDLImage;
+        }
+        else if (SDL_strcasecmp(name, "fast") == 0) {
+            decoder = ImageDecoder::Fast;
+        }
+        else {
+            cout << "Unknown PNG_DECODER " << name << ", expected sdl or fast" << endl;
+        }
+    }
+    setImageDecoder(decoder);
+    cout << "Decoding images with " << getImageDecoderName(decoder) << " into "
+         << SDL_GetPixelFormatName(decodeFormat) << endl;
+}
+
+void setImageDecoder(ImageDecoder decoder)
+{
+    currentDecoder = decoder;
+}
+
+ImageDecoder getImageDecoder()
+{
+    return currentDecoder;
+}
+
+const char* getImageDecoderName(ImageDecoder decoder)
+{
+    return decoder == ImageDecoder::Fast ? "the fast PNG decoder" : "SDL_image";
+}
+
+SDL_Surface* loadImage(const void* data, size_t size)
+{
+    if (currentDecoder == ImageDecoder::Fast) {
+        SDL_Surface* surface = decodePng(data, size, decodeFormat);
+        if (surface) return surface;
+    }
+    return IMG_Load_IO(SDL_IOFromConstMem(data, size), true); //Not a PNG it handles
+}
+
+SDL_Surface* loadImage(const string& path)
+{
+    size_t size = 0;
+    void* data = SDL_LoadFile(path.c_str(), &size);
+    if (!data) return nullptr;
+
+    SDL_Surface* surface = loadImage(data, size);
+    SDL_free(data);
+    return surface;
+}
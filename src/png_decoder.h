@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+
+using namespace std;
+
+// Which decoder images are loaded with. Fast is the PNG decoder in png_decoder.cpp,
+// which falls back to SDL_image for anything it doesn't handle.
+enum class ImageDecoder {
+    SDLImage,
+    Fast
+};
+
+// Picks the decoder and the pixel format decoded images are written in, the renderer's
+// preferred texture format when it is one the fast decoder writes. The PNG_DECODER
+// environment variable ("sdl" or "fast") overrides the default. Call once at startup.
+void initImageDecoder(SDL_Renderer* renderer, ImageDecoder fallback);
+// Safe to call while loads are in flight, the next decode uses the new one
+void setImageDecoder(ImageDecoder decoder);
+ImageDecoder getImageDecoder();
+const char* getImageDecoderName(ImageDecoder decoder);
+
+// Decodes an image held in memory, or read from a file, with the selected decoder
+SDL_Surface* loadImage(const void* data, size_t size);
+SDL_Surface* loadImage(const string& path);
+
+// PNG decoder for 8 bit, non-interlaced images, which is everything the game ships.
+// Inflate decodes Huffman codes through lookup tables fed from a 64 bit bit buffer and
+// copies matches 8 bytes at a time; the row filters are undone with SSE2 or NEON.
+// Each row is written straight into a surface of the given format
+// (SDL_PIXELFORMAT_ARGB8888 or SDL_PIXELFORMAT_ABGR8888), so uploading it to a renderer
+// using that format needs no conversion. Returns nullptr for corrupt or unsupported files.
+// Chunk CRCs and the zlib checksum are not verified, the files are our own.
+SDL_Surface* decodePng(const void* data, size_t size, SDL_PixelFormat format);
@@ -0,0 +1,84 @@
+#include <iostream>
+#include "power_policy.h"
+#include "clock.h"
+#include "frame_pacer.h"
+
+const PowerProfile PowerPolicy::PROFILES[3] = {
+    { "plugged in", 0, 1.0f },
+    { "on battery", 30, 2.0f },
+    { "low battery", 20, 4.0f }
+};
+
+PowerPolicy::PowerPolicy(Clock* clock, FramePacer* pacer)
+    : clock(clock), pacer(pacer), profile(&PROFILES[static_cast<int>(Source::Plugged)])
+{
+    if (const char* profileOverride = SDL_getenv("POWER_PROFILE")) {
+        forced = true;
+        if (SDL_strcasecmp(profileOverride, "battery") == 0) profile = &PROFILES[static_cast<int>(Source::Battery)];
+        else if (SDL_strcasecmp(profileOverride, "low") == 0) profile = &PROFILES[static_cast<int>(Source::LowBattery)];
+        else profile = &PROFILES[static_cast<int>(Source::Plugged)];
+        cout << "Power profile forced to " << getProfile().name << endl;
+    }
+}
+
+void PowerPolicy::update()
+{
+    if (forced) return;
+
+    Uint64 now = SDL_GetTicksNS();
+    if (now < nextPollNS) return;
+    nextPollNS = now + POLL_INTERVAL_NS;
+
+    const PowerProfile* current = &PROFILES[static_cast<int>(readSource())];
+    if (current != profile.load()) {
+        profile = current;
+        cout << "Power profile: " << current->name << endl;
+    }
+}
+
+PowerPolicy::Source PowerPolicy::readSource() const
+{
+    int percent = -1;
+    SDL_PowerState power = SDL_GetPowerInfo(nullptr, &percent);
+    if (power != SDL_POWERSTATE_ON_BATTERY) {
+        return Source::Plugged; //Unknown counts too, desktops without a battery report that
+    }
+    return percent >= 0 && percent <= LOW_BATTERY_PERCENT ? Source::LowBattery : Source::Battery;
+}
+
+void PowerPolicy::handleEvent(const SDL_Event& event)
+{
+    switch (event.type) {
+    case SDL_EVENT_WINDOW_MINIMIZED:
+        minimized = true;
+        break;
+    case SDL_EVENT_WINDOW_RESTORED:
+    case SDL_EVENT_WINDOW_MAXIMIZED:
+        minimized = false;
+        break;
+    case SDL_EVENT_WINDOW_OCCLUDED:
+        occluded = true;
+        break;
+    case SDL_EVENT_WINDOW_EXPOSED:
+        occluded = false;
+        break;
+    case SDL_EVENT_WINDOW_HIDDEN:
+        hidden = true;
+        break;
+    case SDL_EVENT_WINDOW_SHOWN:
+        hidden = false;
+        break;
+    default:
+        return;
+    }
+    applyVisibility();
+}
+
+//Game time stops along with drawing, so a covered minigame doesn't run out its timers unseen
+void PowerPolicy::applyVisibility()
+{
+    bool invisible = minimized || occluded || hidden;
+    if (invisible == pacer->isHidden()) return;
+    pacer->setHidden(invisible);
+    clock->setPaused(invisible);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+
+using namespace std;
+
+class Clock;
+class FramePacer;
+
+// How hard the game runs outside of gameplay. Minigames always get the full frame rate
+// and the 50 Hz tick, so their timing doesn't change with the power state.
+struct PowerProfile {
+    const char* name;
+    int menuFrameCap;      // frame rate cap on the menu and level select, 0 for none
+    float carouselSpeedup; // the level select carousel settles this many times faster
+};
+
+// Picks a PowerProfile from SDL_GetPowerInfo(), checked every few seconds since reading it
+// can mean going through sysfs. Also stops drawing and game time while the window is
+// minimized, hidden or covered by another window, whatever the profile.
+// The POWER_PROFILE environment variable ("plugged", "battery" or "low") forces a profile.
+class PowerPolicy {
+public:
+    PowerPolicy(Clock* clock, FramePacer* pacer);
+
+    // Call once per frame
+    void update();
+    // Call with every event, follows the window's visibility
+    void handleEvent(const SDL_Event& event);
+
+    // Safe to call from the simulation thread
+    const PowerProfile& getProfile() const { return *profile.load(); }
+
+private:
+    enum class Source {
+        Plugged,   // charging, charged or no battery at all
+        Battery,
+        LowBattery // on battery at or below LOW_BATTERY_PERCENT
+    };
+
+    static const PowerProfile PROFILES[3];
+    static const int LOW_BATTERY_PERCENT = 20;
+    static const Uint64 POLL_INTERVAL_NS = 10 * SDL_NS_PER_SECOND;
+
+    Source readSource() const;
+    void applyVisibility();
+
+    Clock* clock;
+    FramePacer* pacer;
+    atomic<const PowerProfile*> profile;
+    Uint64 nextPollNS = 0;
+    bool forced = false;
+    bool minimized = false, occluded = false, hidden = false;
+};
@@ -0,0 +1,159 @@
+#include <iostream>
+#include "simulation.h"
+#include "clock.h"
+#include "frame_pacer.h"
+#include "job_system.h"
+
+Simulation::Simulation(Clock* clock, FramePacer* pacer, JobSystem* jobs, Uint64 tickNS, int maxCatchUpTicks, InputHandler onInput, TickHandler onTick)
+    : clock(clock), pacer(pacer), jobs(jobs), tickNS(tickNS), maxCatchUpTicks(maxCatchUpTicks), onInput(move(onInput)), onTick(move(onTick))
+{
+    world = SDL_CreateMutex();
+    queueMutex = SDL_CreateMutex();
+    workQueued = SDL_CreateCondition();
+}
+
+Simulation::~Simulation()
+{
+    stop();
+    if (workQueued) SDL_DestroyCondition(workQueued);
+    if (queueMutex) SDL_DestroyMutex(queueMutex);
+    if (world) SDL_DestroyMutex(world);
+}
+
+bool Simulation::start()
+{
+    if (thread) return true;
+    if (!world || !queueMutex || !workQueued) {
+        cout << "Error creating simulation locks: " << SDL_GetError() << endl;
+        return false;
+    }
+
+    lastTickNS = SDL_GetTicksNS();
+    stopping = false;
+    thread = SDL_CreateThread(threadMain, "Simulation", this);
+    if (!thread) {
+        cout << "Error creating simulation thread: " << SDL_GetError() << endl;
+        return false;
+    }
+    return true;
+}
+
+void Simulation::stop()
+{
+    if (!thread) return;
+
+    SDL_LockMutex(queueMutex);
+    stopping = true;
+    SDL_SignalCondition(workQueued);
+    SDL_UnlockMutex(queueMutex);
+
+    SDL_WaitThread(thread, nullptr);
+    thread = nullptr;
+}
+
+bool Simulation::isInputEvent(const SDL_Event& event)
+{
+    switch (event.type) {
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+    case SDL_EVENT_TEXT_INPUT:
+    case SDL_EVENT_MOUSE_MOTION:
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+    case SDL_EVENT_MOUSE_WHEEL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void Simulation::queueInput(const SDL_Event& event)
+{
+    SDL_LockMutex(queueMutex);
+    inputs.push_back(event);
+    SDL_SignalCondition(workQueued);
+    SDL_UnlockMutex(queueMutex);
+}
+
+int SDLCALL Simulation::threadMain(void* data)
+{
+    static_cast<Simulation*>(data)->run();
+    return 0;
+}
+
+void Simulation::run()
+{
+    Uint64 nextTickNS = SDL_GetTicksNS();
+    vector<SDL_Event> pending;
+    while (!stopping) {
+        waitForWork(nextTickNS, pending);
+        if (stopping) break;
+
+        lock();
+        //Input first, so a tick that's due sees it
+        clock->sample();
+        bool changed = !pending.empty(); //Input can change anything on screen
+        for (const SDL_Event& event : pending) {
+            onInput(event);
+        }
+        pending.clear();
+
+        int ticks = 0;
+        while (clock->realNS() >= nextTickNS && ticks < maxCatchUpTicks && !stopping) {
+            if (ticks > 0) {
+                clock->sample();
+            }
+            if (!clock->isPaused()) { //Paused while the window can't be seen, game time isn't moving
+                changed = onTick() || changed;
+            }
+            lastTickNS = nextTickNS;
+            nextTickNS += tickNS;
+            ticks++;
+        }
+        if (clock->realNS() >= nextTickNS) {
+            nextTickNS = clock->realNS() + tickNS; //Too far behind, drop the ticks rather than rush them
+        }
+        unlock();
+
+        //Only after unlocking, so the frame it wakes up for can take the world lock.
+        //Once dirty, the main thread is going to draw anyway and needs no more wake ups.
+        if (changed && (!pacer || pacer->markDirty())) {
+            jobs->wakeMainThread();
+        }
+    }
+}
+
+//Returns once input is waiting or the next tick is due
+void Simulation::waitForWork(Uint64 nextTickNS, vector<SDL_Event>& pending)
+{
+    SDL_LockMutex(queueMutex);
+    while (!stopping && inputs.empty()) {
+        Uint64 now = SDL_GetTicksNS();
+        if (now >= nextTickNS) break;
+
+        Uint64 left = nextTickNS - now;
+        if (left <= SPIN_NS) {
+            //Condition timeouts are only as precise as the OS timer, finish with a precise sleep
+            SDL_UnlockMutex(queueMutex);
+            SDL_DelayPrecise(left);
+            SDL_LockMutex(queueMutex);
+            break;
+        }
+        Sint32 timeoutMS = static_cast<Sint32>((left - SPIN_NS + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS);
+        SDL_WaitConditionTimeout(workQueued, queueMutex, timeoutMS);
+    }
+    pending.swap(inputs);
+    SDL_UnlockMutex(queueMutex);
+}
+
+bool Simulation::queueOnMainThread(const char* name, function<void()> work)
+{
+    if (SDL_IsMainThread() || !thread) {
+        work();
+        return true;
+    }
+    if (stopping) return false; //The loop that pumps main thread jobs is ending
+
+    jobs->queueOnMainThread(name, move(work));
+    return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+class Clock;
+class FramePacer;
+class JobSystem;
+
+// Runs the game's ticks, and applies keyboard and mouse input, on a thread of its own, so
+// a slow frame, a long vsync wait or a texture upload on the main thread doesn't hold up
+// the 50 Hz game timing, and a slow tick doesn't hold up drawing.
+//
+// Everything the scenes own is guarded by the world lock. Ticks and input hold it; the
+// main thread takes it only while scenes record their draw calls and to swap in minigames
+// it built without it, and releases it before presenting. Nothing loads under it: textures
+// evicted while drawing reload in TextureCache::beginFrame(). The scenes' state as of the
+// last tick is what each frame draws, and a tick or input that changed it marks the pacer
+// dirty, so on demand pacing draws it.
+//
+// SDL only allows windows, cursors and the renderer to be used from the main thread, so a
+// tick that needs them, like starting a minigame, queues that part with queueOnMainThread().
+// It goes on the JobSystem's main thread queue, which runs before the next frame is drawn,
+// never in the middle of a tick.
+class Simulation {
+public:
+    using InputHandler = function<void(const SDL_Event&)>;
+    using TickHandler = function<bool()>; // returns true if the tick changed what's on screen
+
+    Simulation(Clock* clock, FramePacer* pacer, JobSystem* jobs, Uint64 tickNS, int maxCatchUpTicks, InputHandler onInput, TickHandler onTick);
+    ~Simulation();
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    bool start();
+    // Waits for the thread to finish its tick. Main thread work still queued is dropped.
+    void stop();
+
+    // Keyboard and mouse events go to the simulation thread, the rest are handled on the main thread
+    static bool isInputEvent(const SDL_Event& event);
+    void queueInput(const SDL_Event& event);
+
+    // The world lock, see above
+    void lock() { SDL_LockMutex(world); }
+    void unlock() { SDL_UnlockMutex(world); }
+
+    // When the last tick was due, with the world lock held. Rendering interpolates from it.
+    Uint64 getLastTickNS() const { return lastTickNS; }
+
+    // Queues work as a main thread job, see JobSystem::queueOnMainThread(). Runs work straight
+    // away when called on the main thread or with no simulation thread running.
+    // Returns false, without running work, once stopping.
+    bool queueOnMainThread(const char* name, function<void()> work);
+
+private:
+    static int SDLCALL threadMain(void* data);
+    void run();
+    void waitForWork(Uint64 nextTickNS, vector<SDL_Event>& pending);
+
+    const Uint64 SPIN_NS = 2 * SDL_NS_PER_MS; // the last stretch before a tick is slept precisely rather than waited on
+
+    Clock* clock;
+    FramePacer* pacer;
+    JobSystem* jobs;
+    Uint64 tickNS;
+    int maxCatchUpTicks;
+    InputHandler onInput;
+    TickHandler onTick;
+
+    SDL_Thread* thread = nullptr;
+    atomic<bool> stopping{ false };
+    SDL_Mutex* world = nullptr;
+    Uint64 lastTickNS = 0; // guarded by world
+
+    SDL_Mutex* queueMutex = nullptr; // guards inputs
+    SDL_Condition* workQueued = nullptr;
+    vector<SDL_Event> inputs;
+};
@@ -0,0 +1,97 @@
+#include "sprite_atlas.h"
+#include <cstdio>
+#include <iostream>
+
+using namespace std;
+
+//Manifest format, one entry per line:
+//  page <page file>
+//  sprite <sprite path> <x> <y> <w> <h> <trimX> <trimY> <width> <height>
+//Sprites belong to the page line above them and paths are relative to the game folder.
+bool SpriteAtlas::loadManifest(const string& path)
+{
+    size_t dataSize = 0;
+    char* data = static_cast<char*>(SDL_LoadFile(path.c_str(), &dataSize));
+    if (!data) {
+        return false; //No atlas built, everything loads as loose files
+    }
+
+    string contents(data, dataSize);
+    SDL_free(data);
+
+    string page;
+    size_t lineStart = 0;
+    while (lineStart < contents.size()) {
+        size_t lineEnd = contents.find('\n', lineStart);
+        if (lineEnd == string::npos) lineEnd = contents.size();
+        string line = contents.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        char name[512];
+        AtlasSprite sprite;
+        SDL_FRect& r = sprite.rect;
+        SDL_FRect& t = sprite.trimmed;
+        if (SDL_sscanf(line.c_str(), "page %511s", name) == 1) {
+            page = name;
+        }
+        else if (SDL_sscanf(line.c_str(), "sprite %511s %f %f %f %f %f %f %f %f", name,
+            &r.x, &r.y, &r.w, &r.h, &t.x, &t.y, &sprite.width, &sprite.height) == 9 && !page.empty()) {
+            sprite.page = page;
+            t.w = r.w;
+            t.h = r.h;
+            sprites[normalizePath(name)] = sprite;
+        }
+        else {
+            cout << "Bad line in atlas manifest " << path << ": " << line << endl;
+        }
+    }
+
+    cout << "Loaded sprite atlas with " << sprites.size() << " sprites" << endl;
+    return true;
+}
+
+const AtlasSprite* SpriteAtlas::find(const string& spritePath) const
+{
+    auto it = sprites.find(normalizePath(spritePath));
+    return it != sprites.end() ? &it->second : nullptr;
+}
+
+//Sprite files are referenced with inconsistent extension case (bg.png vs bg.PNG),
+//which only works on case-insensitive file systems, so lookups ignore case
+string SpriteAtlas::normalizePath(const string& path)
+{
+    string result = path;
+    for (char& c : result) {
+        if (c == '\\') c = '/';
+        else c = static_cast<char>(SDL_tolower(static_cast<unsigned char>(c)));
+    }
+    return result;
+}
+
+bool mapSpriteRect(const AtlasSprite& sprite, const SDL_FRect& src, const SDL_FRect& dst,
+    SDL_FRect& pageSrc, SDL_FRect& pageDst)
+{
+    SDL_FRect visible;
+    if (src.w <= 0.0f || src.h <= 0.0f || !SDL_GetRectIntersectionFloat(&src, &sprite.trimmed, &visible)) {
+        return false;
+    }
+
+    float scaleX = dst.w / src.w;
+    float scaleY = dst.h / src.h;
+    pageDst = {
+        dst.x + (visible.x - src.x) * scaleX,
+        dst.y + (visible.y - src.y) * scaleY,
+        visible.w * scaleX,
+        visible.h * scaleY
+    };
+    pageSrc = {
+        sprite.rect.x + (visible.x - sprite.trimmed.x),
+        sprite.rect.y + (visible.y - sprite.trimmed.y),
+        visible.w,
+        visible.h
+    };
+    return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// Where a sprite ended up inside an atlas page.
+// Transparent borders are trimmed when packing, so trimmed is the part of the
+// original image that was kept and rect is where that part sits on the page.
+struct AtlasSprite {
+    string page;
+    SDL_FRect rect;
+    SDL_FRect trimmed;
+    float width = 0.0f;  // size of the original image
+    float height = 0.0f;
+};
+
+// Lookup from sprite paths to their place in the packed atlas pages.
+// The pages and manifest are generated by tools/atlas_packer.cpp. Without a
+// manifest the lookup is empty and sprites load as loose files.
+class SpriteAtlas {
+public:
+    bool loadManifest(const string& path);
+    const AtlasSprite* find(const string& spritePath) const;
+    size_t getSpriteCount() const { return sprites.size(); }
+
+    static string normalizePath(const string& path);
+
+private:
+    unordered_map<string, AtlasSprite> sprites; // keyed by normalized sprite path
+};
+
+// Maps a draw of a sprite (src in original image coordinates) onto its atlas page.
+// Returns false when the requested part was trimmed away entirely and nothing needs drawing.
+bool mapSpriteRect(const AtlasSprite& sprite, const SDL_FRect& src, const SDL_FRect& dst,
+    SDL_FRect& pageSrc, SDL_FRect& pageDst);
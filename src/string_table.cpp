@@ -0,0 +1,259 @@
+#include "string_table.h"
+#include "text_renderer.h"
+#include <iostream>
+
+using namespace std;
+
+namespace {
+    const char* STRINGS_DIR = "src/res/strings/";
+
+    struct DefaultString {
+        const char* name;
+        const char* text;
+    };
+
+    // Must follow the order of StringId
+    const DefaultString ENGLISH[] = {
+        { "Start", "Start!" },
+        { "Finished", "Finished!" },
+        { "CutsRemainingFmt", "Cuts Remaining: %d" },
+        { "MixProgressFmt", "Mix progress: %d%%" },
+        { "TimeLeftFmt", "Time left: %.1fs" },
+        { "MixInstructions", "Circle the bowl or press Spacebar to mix!" },
+        { "EggCountFmt", "EGG %d / %d" },
+        { "EggsCrackedFmt", "EGGS CRACKED: %d" },
+        { "CrackInstructions", "Press SPACE to crack!" },
+        { "CrackInstructionsEndless", "Press SPACE to crack! Don't miss!" },
+        { "ReadyFmt", "Ready? %d" },
+        { "Go", "Go!" },
+        { "CrackResultShell", "You got shell everywhere!" },
+        { "CrackResultMessy", "You're messy..." },
+        { "CrackResultAlmost", "Almost EGGcelent!" },
+        { "CrackResultPerfect", "PERFECT CRACK!" },
+        { "AllEggsCrackedFmt", "All eggs cracked! Score: %d/100" },
+        { "EndlessGameOverFmt", "Game over! Eggs cracked: %d" },
+    };
+    static_assert(SDL_arraysize(ENGLISH) == static_cast<size_t>(StringId::Count), "ENGLISH must list every StringId");
+
+    bool isFormat(const char* name)
+    {
+        size_t length = SDL_strlen(name);
+        return length >= 3 && SDL_strcmp(name + length - 3, "Fmt") == 0;
+    }
+
+    //The argument types a printf format reads, in order, eg. "EGG %d / %.1f" -> "df".
+    //Returns false for anything SDL_snprintf could misread, like a stray % at the end or %n.
+    bool formatArguments(const string& format, string& arguments)
+    {
+        arguments.clear();
+        for (size_t i = 0; i < format.size(); i++) {
+            if (format[i] != '%') continue;
+            if (++i >= format.size()) return false;
+            if (format[i] == '%') continue;
+
+            while (i < format.size() && SDL_strchr("-+ #0", format[i])) i++;
+            while (i < format.size() && (SDL_isdigit(format[i]) || format[i] == '.')) i++;
+            if (i < format.size() && (format[i] == '*' || format[i] == '$')) return false; //Widths from arguments and positional arguments aren't used by any string
+            string length;
+            while (i < format.size() && SDL_strchr("hlLjzt", format[i])) length += format[i++];
+            if (i >= format.size()) return false;
+
+            char type;
+            switch (format[i]) {
+            case 'd': case 'i': type = 'd'; break;
+            case 'u': case 'o': case 'x': case 'X': type = 'u'; break;
+            case 'c': type = 'c'; break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': type = 'f'; break;
+            case 's': type = 's'; break;
+            case 'p': type = 'p'; break;
+            default: return false;
+            }
+            arguments += length + type;
+        }
+        return true;
+    }
+}
+
+StringTable::StringTable(TextRenderer* textRenderer)
+    : textRenderer(textRenderer)
+{
+    Language english;
+    english.code = "en";
+    for (const DefaultString& entry : ENGLISH) {
+        english.strings.push_back(entry.text);
+    }
+    languages.push_back(english);
+
+    //Every other table in the strings folder is a translation
+    int count = 0;
+    char** files = SDL_GlobDirectory(STRINGS_DIR, "*.txt", 0, &count);
+    if (files) {
+        for (int i = 0; i < count; i++) {
+            string file = files[i];
+            loadLanguage(file.substr(0, file.size() - 4));
+        }
+        SDL_free(files);
+    }
+}
+
+bool StringTable::loadLanguage(const string& code)
+{
+    if (findLanguage(code) >= 0) return true;
+
+    string path = STRINGS_DIR + code + ".txt";
+    size_t dataSize = 0;
+    char* data = static_cast<char*>(SDL_LoadFile(path.c_str(), &dataSize));
+    if (!data) {
+        cout << "Error loading string table " << path << ": " << SDL_GetError() << endl;
+        return false;
+    }
+
+    Language language;
+    language.code = code;
+    language.strings = languages[0].strings; //Untranslated entries stay English
+
+    string contents(data, dataSize);
+    SDL_free(data);
+
+    size_t lineStart = 0;
+    while (lineStart < contents.size()) {
+        size_t lineEnd = contents.find('\n', lineStart);
+        if (lineEnd == string::npos) lineEnd = contents.size();
+        string line = contents.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t split = line.find('=');
+        if (split == string::npos) continue;
+
+        string key = line.substr(0, split);
+        bool found = false;
+        for (size_t i = 0; i < SDL_arraysize(ENGLISH); i++) {
+            if (key == ENGLISH[i].name) {
+                string text = line.substr(split + 1);
+                found = true;
+
+                //The translation is handed to SDL_snprintf with the English arguments
+                string expected, actual;
+                if (isFormat(ENGLISH[i].name) && (!formatArguments(ENGLISH[i].text, expected) ||
+                    !formatArguments(text, actual) || actual != expected)) {
+                    cout << key << " in " << path << " doesn't take the same % fields as \"" << ENGLISH[i].text
+                         << "\", keeping English" << endl;
+                    break;
+                }
+                language.strings[i] = text;
+                break;
+            }
+        }
+        if (!found) {
+            cout << "Unknown string ID " << key << " in " << path << endl;
+        }
+    }
+
+    languages.push_back(language);
+    return true;
+}
+
+int StringTable::findLanguage(const string& code) const
+{
+    for (size_t i = 0; i < languages.size(); i++) {
+        if (languages[i].code == code) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void StringTable::selectPreferredLanguage()
+{
+    int count = 0;
+    SDL_Locale** locales = SDL_GetPreferredLocales(&count);
+    if (!locales) return;
+
+    for (int i = 0; i < count; i++) {
+        if (locales[i]->language && findLanguage(locales[i]->language) >= 0) {
+            setLanguage(locales[i]->language);
+            break;
+        }
+    }
+    SDL_free(locales);
+}
+
+bool StringTable::setLanguage(const string& code)
+{
+    int index = findLanguage(code);
+    if (index < 0) return false;
+    if (index == currentLanguage) return true;
+
+    currentLanguage = index;
+    for (TTF_Font* font : fonts) {
+        applyLanguageToFont(font);
+    }
+
+    //One shaping pass for everything that was prepared, nothing per frame afterwards
+    for (const auto& entry : prepared) {
+        getRun(entry.first, entry.second);
+    }
+
+    cout << "Language set to " << code << endl;
+    return true;
+}
+
+void StringTable::cycleLanguage()
+{
+    int next = (currentLanguage + 1) % static_cast<int>(languages.size());
+    setLanguage(languages[next].code);
+}
+
+const char* StringTable::get(StringId id) const
+{
+    return languages[currentLanguage].strings[static_cast<size_t>(id)].c_str();
+}
+
+void StringTable::applyLanguageToFont(TTF_Font* font)
+{
+    TTF_SetFontLanguage(font, getLanguage().c_str());
+}
+
+TextLabel& StringTable::getRun(StringId id, TTF_Font* font)
+{
+    auto key = make_tuple(currentLanguage, id, font);
+    auto it = runs.find(key);
+    if (it != runs.end()) {
+        return *it->second;
+    }
+
+    if (fonts.insert(font).second) {
+        applyLanguageToFont(font);
+    }
+
+    auto run = make_unique<TextLabel>();
+    run->setText(textRenderer, font, get(id), SDL_Color{ 255, 255, 255, SDL_ALPHA_OPAQUE });
+    TextLabel& result = *run;
+    runs[key] = move(run);
+    return result;
+}
+
+void StringTable::prepare(StringId id, TTF_Font* font)
+{
+    if (!font) return;
+
+    prepared.insert(make_pair(id, font));
+    getRun(id, font);
+}
+
+void StringTable::draw(StringId id, TTF_Font* font, float x, float y, SDL_Color color,
+    float anchorX, float anchorY, float scale)
+{
+    if (!font) return;
+
+    TextLabel& run = getRun(id, font);
+    run.setText(textRenderer, font, get(id), color); //Same text, so only the color can change
+    run.render(x, y, anchorX, anchorY, scale);
+}
+
+SDL_FPoint StringTable::getSize(StringId id, TTF_Font* font)
+{
+    if (!font) return SDL_FPoint{ 0.0f, 0.0f };
+    return getRun(id, font).getSize();
+}
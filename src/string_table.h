@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "text_label.h"
+
+using namespace std;
+
+// Every user facing string. Entries ending in Fmt are SDL_snprintf formats.
+enum class StringId {
+    Start,
+    Finished,
+    CutsRemainingFmt,
+    MixProgressFmt,
+    TimeLeftFmt,
+    MixInstructions,
+    EggCountFmt,
+    EggsCrackedFmt,
+    CrackInstructions,
+    CrackInstructionsEndless,
+    ReadyFmt,
+    Go,
+    CrackResultShell,
+    CrackResultMessy,
+    CrackResultAlmost,
+    CrackResultPerfect,
+    AllEggsCrackedFmt,
+    EndlessGameOverFmt,
+    Count
+};
+
+// Localized string tables plus a cache of shaped text runs.
+// English is built in; other languages are read from src/res/strings/<code>.txt
+// as ID=text lines, where ID is the enum name. Missing entries fall back to English. Fixed strings are shaped once per (string, language, font)
+// with prepare() at load time, so drawing them does no text work and switching
+// languages costs a single re-shaping pass.
+class StringTable {
+public:
+    StringTable(TextRenderer* textRenderer);
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    // Picks the first of the OS preferred locales we have a table for
+    void selectPreferredLanguage();
+    bool setLanguage(const string& code);
+    void cycleLanguage();
+    const string& getLanguage() const { return languages[currentLanguage].code; }
+
+    const char* get(StringId id) const;
+
+    // Shapes the string in this font for the current language ahead of time
+    void prepare(StringId id, TTF_Font* font);
+    void draw(StringId id, TTF_Font* font, float x, float y, SDL_Color color,
+        float anchorX = 0.0f, float anchorY = 0.0f, float scale = 1.0f);
+    SDL_FPoint getSize(StringId id, TTF_Font* font);
+
+private:
+    struct Language {
+        string code; // BCP 47, eg. "es"
+        vector<string> strings;
+    };
+
+    bool loadLanguage(const string& code);
+    int findLanguage(const string& code) const;
+    TextLabel& getRun(StringId id, TTF_Font* font);
+    void applyLanguageToFont(TTF_Font* font);
+
+    TextRenderer* textRenderer;
+    vector<Language> languages;
+    int currentLanguage = 0;
+
+    // Shaped runs keyed by (language, string, font size)
+    map<tuple<int, StringId, TTF_Font*>, unique_ptr<TextLabel>> runs;
+    set<pair<StringId, TTF_Font*>> prepared; // what to re-shape when the language changes
+    set<TTF_Font*> fonts;
+};
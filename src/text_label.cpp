@@ -0,0 +1,56 @@
+#include "text_label.h"
+#include <cstring>
+
+using namespace std;
+
+atomic<uint64_t> TextLabel::rebuildCount{ 0 };
+
+TextLabel::~TextLabel()
+{
+    if (ttfText) {
+        TTF_DestroyText(ttfText);
+    }
+}
+
+void TextLabel::setText(TextRenderer* textRenderer, TTF_Font* newFont, const char* newText, SDL_Color newColor)
+{
+    if (!textRenderer || !newFont || !newText) return;
+
+    bool textChanged = !ttfText || newFont != font || strcmp(newText, text.c_str()) != 0;
+
+    if (textChanged) {
+        if (!ttfText) {
+            ttfText = TTF_CreateText(textRenderer->getEngine(), newFont, newText, 0);
+            if (!ttfText) return;
+            renderer = textRenderer->getRenderer();
+        }
+        else {
+            if (newFont != font) {
+                TTF_SetTextFont(ttfText, newFont);
+            }
+            TTF_SetTextString(ttfText, newText, 0);
+        }
+
+        font = newFont;
+        text = newText;
+
+        int w = 0, h = 0;
+        TTF_GetTextSize(ttfText, &w, &h);
+        size = { static_cast<float>(w), static_cast<float>(h) };
+        rebuildCount++;
+    }
+
+    //Color is applied per vertex, so changing it needs no re-layout
+    if (textChanged || newColor.r != color.r || newColor.g != color.g ||
+        newColor.b != color.b || newColor.a != color.a) {
+        TTF_SetTextColor(ttfText, newColor.r, newColor.g, newColor.b, newColor.a);
+        color = newColor;
+    }
+}
+
+void TextLabel::render(float x, float y, float anchorX, float anchorY, float scale) const
+{
+    if (!ttfText || text.empty()) return;
+
+    TextRenderer::drawScaled(renderer, ttfText, x - size.x * scale * anchorX, y - size.y * scale * anchorY, scale);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <atomic>
+#include <string>
+#include "text_renderer.h"
+
+using namespace std;
+
+// Retained text for HUD strings that change rarely.
+// Keeps its last string, font, color and laid out glyphs, and only rebuilds
+// when one of them actually changes, so a steady HUD costs no text work per frame.
+class TextLabel {
+public:
+    TextLabel() = default;
+    ~TextLabel();
+    TextLabel(const TextLabel&) = delete;
+    TextLabel& operator=(const TextLabel&) = delete;
+
+    // Cheap when nothing changed: just compares against the cached values
+    void setText(TextRenderer* textRenderer, TTF_Font* font, const char* newText, SDL_Color newColor);
+    // scale stretches the laid out glyphs; draw from a larger font and scale down for crisp zooms
+    void render(float x, float y, float anchorX = 0.0f, float anchorY = 0.0f, float scale = 1.0f) const;
+
+    SDL_FPoint getSize() const { return size; }
+    const string& getText() const { return text; }
+
+    // Total number of times any label had to re-layout its text. Should stay flat across a
+    // steady HUD; growth means labels are being rebuilt every frame.
+    static uint64_t getRebuildCount() { return rebuildCount; }
+
+private:
+    SDL_Renderer* renderer = nullptr;
+    TTF_Text* ttfText = nullptr;
+    TTF_Font* font = nullptr;
+    string text;
+    SDL_Color color = { 0, 0, 0, 0 };
+    SDL_FPoint size = { 0.0f, 0.0f };
+
+    static atomic<uint64_t> rebuildCount; // labels are set on the simulation thread and drawn on the main one
+};
@@ -0,0 +1,62 @@
+#include "text_layout.h"
+#include <sstream>
+
+using namespace std;
+
+float TextLayout::measureWidth(TTF_Font* font, const string& text)
+{
+    if (!font || text.empty()) return 0.0f;
+
+    const char* cursor = text.c_str();
+    size_t remaining = text.size();
+    Uint32 previous = 0;
+    int width = 0;
+
+    Uint32 ch;
+    while ((ch = SDL_StepUTF8(&cursor, &remaining)) != 0) {
+        if (previous != 0) {
+            int kerning = 0;
+            if (TTF_GetGlyphKerning(font, previous, ch, &kerning)) {
+                width += kerning;
+            }
+        }
+
+        int advance = 0;
+        if (TTF_GetGlyphMetrics(font, ch, nullptr, nullptr, nullptr, nullptr, &advance)) {
+            width += advance;
+        }
+        previous = ch;
+    }
+
+    return static_cast<float>(width);
+}
+
+vector<TextLayout::Line> TextLayout::wrapWords(TTF_Font* font, const string& text, float maxWidth)
+{
+    vector<Line> lines;
+    Line currentLine;
+    stringstream ss(text);
+    string word;
+
+    while (ss >> word) {
+        string testLine = currentLine.text.empty() ? word : currentLine.text + " " + word;
+        float testWidth = measureWidth(font, testLine);
+
+        if (testWidth > maxWidth && !currentLine.text.empty()) {
+            // Line is too long, save current line and start new one
+            lines.push_back(currentLine);
+            currentLine.text = word;
+            currentLine.width = measureWidth(font, word);
+        }
+        else {
+            // Add word to current line
+            currentLine.text = testLine;
+            currentLine.width = testWidth;
+        }
+    }
+    if (!currentLine.text.empty()) {
+        lines.push_back(currentLine);
+    }
+
+    return lines;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Line breaking from font metrics only (glyph advances and kerning).
+// Nothing here rasterizes, so it is cheap enough to run whenever a layout
+// has to be rebuilt, but callers should still cache the result.
+namespace TextLayout {
+    struct Line {
+        string text;
+        float width = 0.0f;
+    };
+
+    // Width of a single line of UTF-8 text in pixels
+    float measureWidth(TTF_Font* font, const string& text);
+
+    // Greedy word wrap. A word wider than maxWidth gets a line to itself.
+    vector<Line> wrapWords(TTF_Font* font, const string& text, float maxWidth);
+}
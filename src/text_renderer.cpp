@@ -0,0 +1,86 @@
+#include "text_renderer.h"
+#include <iostream>
+
+using namespace std;
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer)
+    : renderer(renderer)
+{
+    engine = TTF_CreateRendererTextEngine(renderer);
+    if (!engine) {
+        cout << "Error creating text engine: " << SDL_GetError() << endl;
+    }
+}
+
+TextRenderer::~TextRenderer()
+{
+    for (auto& pair : scratchTexts) {
+        TTF_DestroyText(pair.second);
+    }
+    scratchTexts.clear();
+
+    if (engine) {
+        TTF_DestroyRendererTextEngine(engine);
+    }
+}
+
+//Returns the text object used for one-off strings in this font, creating it on first use
+TTF_Text* TextRenderer::getScratchText(TTF_Font* font)
+{
+    auto it = scratchTexts.find(font);
+    if (it != scratchTexts.end()) {
+        return it->second;
+    }
+
+    TTF_Text* text = TTF_CreateText(engine, font, "", 0);
+    if (text) {
+        scratchTexts[font] = text;
+    }
+    return text;
+}
+
+SDL_FPoint TextRenderer::measureText(TTF_Font* font, const string& text)
+{
+    SDL_FPoint size = { 0.0f, 0.0f };
+    if (!engine || !font || text.empty()) return size;
+
+    TTF_Text* ttfText = getScratchText(font);
+    if (!ttfText || !TTF_SetTextString(ttfText, text.c_str(), text.size())) return size;
+
+    int w = 0, h = 0;
+    TTF_GetTextSize(ttfText, &w, &h);
+    size.x = static_cast<float>(w);
+    size.y = static_cast<float>(h);
+    return size;
+}
+
+SDL_FPoint TextRenderer::drawText(TTF_Font* font, const string& text, float x, float y, SDL_Color color,
+    float anchorX, float anchorY, float scale)
+{
+    SDL_FPoint size = measureText(font, text);
+    if (size.x <= 0.0f) return size;
+
+    TTF_Text* ttfText = scratchTexts[font];
+    TTF_SetTextColor(ttfText, color.r, color.g, color.b, color.a);
+
+    float drawX = x - size.x * scale * anchorX;
+    float drawY = y - size.y * scale * anchorY;
+
+    drawScaled(renderer, ttfText, drawX, drawY, scale);
+    return size;
+}
+
+void TextRenderer::drawScaled(SDL_Renderer* renderer, TTF_Text* text, float x, float y, float scale)
+{
+    if (scale == 1.0f) {
+        TTF_DrawRendererText(text, x, y);
+        return;
+    }
+
+    //Glyph quads go through SDL_RenderGeometry, so the render scale stretches them
+    float oldScaleX, oldScaleY;
+    SDL_GetRenderScale(renderer, &oldScaleX, &oldScaleY);
+    SDL_SetRenderScale(renderer, oldScaleX * scale, oldScaleY * scale);
+    TTF_DrawRendererText(text, x / scale, y / scale);
+    SDL_SetRenderScale(renderer, oldScaleX, oldScaleY);
+}
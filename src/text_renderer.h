@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// Draws text through SDL_ttf's renderer text engine.
+// Each glyph of a font is rasterized once into a shared atlas texture and strings
+// are drawn as batched quads, so drawing text creates no surfaces or textures
+// once the glyphs it uses have been seen.
+class TextRenderer {
+public:
+    TextRenderer(SDL_Renderer* renderer);
+    ~TextRenderer();
+
+    TTF_TextEngine* getEngine() const { return engine; }
+    SDL_Renderer* getRenderer() const { return renderer; }
+
+    // Draws text with its anchor point at (x, y). anchorX/anchorY are fractions of the
+    // text size, eg. (0.5, 0.5) centers the text on the point and (0, 1) puts its
+    // bottom left corner there. Returns the unscaled size of the drawn text.
+    // The string is laid out again on every call, use a TextLabel for text drawn every frame.
+    SDL_FPoint drawText(TTF_Font* font, const string& text, float x, float y, SDL_Color color,
+        float anchorX = 0.0f, float anchorY = 0.0f, float scale = 1.0f);
+    SDL_FPoint measureText(TTF_Font* font, const string& text);
+
+    // Draws already laid out text with its top left at (x, y), scaled around that point.
+    // Scaling only changes the quads, the glyphs in the atlas are reused as they are.
+    static void drawScaled(SDL_Renderer* renderer, TTF_Text* text, float x, float y, float scale);
+
+private:
+    TTF_Text* getScratchText(TTF_Font* font);
+
+    SDL_Renderer* renderer;
+    TTF_TextEngine* engine = nullptr;
+    unordered_map<TTF_Font*, TTF_Text*> scratchTexts; //One reusable text object per font
+};
@@ -0,0 +1,675 @@
+#include "texture_cache.h"
+#include "asset_loader.h"
+#include "png_decoder.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+using namespace std;
+
+namespace {
+    const char* ATLAS_MANIFEST = "src/res/atlas/atlas.txt";
+    const char* BUNDLE_PATH = "src/res/assets.bundle";
+    const char* RES_DIR = "src/res/";
+    const char* THUMBNAILS_PATH = "src/res/thumbnails.bin";
+    const char* TIERS_MANIFEST = "src/res/tiers/tiers.txt";
+}
+
+// -------- TextureHandle --------
+
+TextureHandle::TextureHandle(TextureCache* cache, TextureEntry* entry)
+    : cache(cache), entry(entry)
+{
+    if (entry) cache->addRef(entry);
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other)
+    : cache(other.cache), entry(other.entry), sprite(other.sprite)
+{
+    if (entry) cache->addRef(entry);
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept
+    : cache(other.cache), entry(other.entry), sprite(other.sprite)
+{
+    other.cache = nullptr;
+    other.entry = nullptr;
+    other.sprite = nullptr;
+}
+
+TextureHandle& TextureHandle::operator=(const TextureHandle& other)
+{
+    if (this != &other) {
+        if (other.entry) other.cache->addRef(other.entry);
+        reset();
+        cache = other.cache;
+        entry = other.entry;
+        sprite = other.sprite;
+    }
+    return *this;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle&& other) noexcept
+{
+    if (this != &other) {
+        reset();
+        cache = other.cache;
+        entry = other.entry;
+        sprite = other.sprite;
+        other.cache = nullptr;
+        other.entry = nullptr;
+        other.sprite = nullptr;
+    }
+    return *this;
+}
+
+TextureHandle::~TextureHandle()
+{
+    reset();
+}
+
+SDL_Texture* TextureHandle::get() const
+{
+    if (!entry) return nullptr;
+    if (entry->texture) return entry->texture; //The thumbnail while still loading
+    return entry->loadId || entry->evicted ? cache->placeholder : nullptr;
+}
+
+void TextureHandle::reset()
+{
+    if (entry) {
+        cache->release(entry);
+    }
+    cache = nullptr;
+    entry = nullptr;
+    sprite = nullptr;
+}
+
+float TextureHandle::getWidth() const
+{
+    if (sprite) return sprite->width;
+    return entry ? entry->width : 0.0f;
+}
+
+float TextureHandle::getHeight() const
+{
+    if (sprite) return sprite->height;
+    return entry ? entry->height : 0.0f;
+}
+
+//Texture to draw this frame, bringing back an evicted one and noting the use for the LRU
+SDL_Texture* TextureHandle::prepareDraw() const
+{
+    if (!entry) return nullptr;
+    if (entry->evicted) {
+        cache->queueReload(entry);
+    }
+    if (!entry->texture) return nullptr;
+
+    entry->lastDrawnFrame = cache->frame;
+    return entry->texture;
+}
+
+//Works out which part of the page to draw where. Loose textures pass straight through.
+bool TextureHandle::mapToPage(SDL_Renderer* renderer, const SDL_FRect* src, const SDL_FRect* dst,
+    SDL_FRect& pageSrc, SDL_FRect& pageDst) const
+{
+    SDL_FRect fullSrc = { 0.0f, 0.0f, sprite->width, sprite->height };
+    SDL_FRect target;
+    if (dst) {
+        target = *dst;
+    }
+    else { //Whole render target, in logical coordinates when a logical size is set
+        int w = 0, h = 0;
+        SDL_GetRenderLogicalPresentation(renderer, &w, &h, nullptr);
+        if (w == 0 || h == 0) {
+            SDL_GetCurrentRenderOutputSize(renderer, &w, &h);
+        }
+        target = { 0.0f, 0.0f, static_cast<float>(w), static_cast<float>(h) };
+    }
+    if (!mapSpriteRect(*sprite, src ? *src : fullSrc, target, pageSrc, pageDst)) return false;
+
+    //The page may be a downscaled tier
+    pageSrc = { pageSrc.x * entry->scale, pageSrc.y * entry->scale, pageSrc.w * entry->scale, pageSrc.h * entry->scale };
+    return true;
+}
+
+void TextureHandle::render(SDL_Renderer* renderer, const SDL_FRect* src, const SDL_FRect* dst) const
+{
+    if (!prepareDraw()) return;
+
+    if (!sprite) {
+        SDL_FRect scaledSrc;
+        if (src) {
+            scaledSrc = { src->x * entry->scale, src->y * entry->scale, src->w * entry->scale, src->h * entry->scale };
+        }
+        SDL_RenderTexture(renderer, entry->texture, src ? &scaledSrc : nullptr, dst);
+        return;
+    }
+
+    SDL_FRect pageSrc, pageDst;
+    if (mapToPage(renderer, src, dst, pageSrc, pageDst)) {
+        SDL_RenderTexture(renderer, entry->texture, &pageSrc, &pageDst);
+    }
+}
+
+void TextureHandle::renderRotated(SDL_Renderer* renderer, const SDL_FRect* src, const SDL_FRect* dst,
+    double angle, SDL_FlipMode flip) const
+{
+    if (!prepareDraw()) return;
+
+    if (!sprite) {
+        SDL_FRect scaledSrc;
+        if (src) {
+            scaledSrc = { src->x * entry->scale, src->y * entry->scale, src->w * entry->scale, src->h * entry->scale };
+        }
+        SDL_RenderTextureRotated(renderer, entry->texture, src ? &scaledSrc : nullptr, dst, angle, nullptr, flip);
+        return;
+    }
+
+    SDL_FRect pageSrc, pageDst;
+    if (!mapToPage(renderer, src, dst, pageSrc, pageDst)) return;
+
+    //Trimming moved the quad off center, mirror it back for flips and rotate around the untrimmed center
+    SDL_FRect target = dst ? *dst : pageDst;
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        pageDst.x = target.x + target.w - (pageDst.x - target.x) - pageDst.w;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        pageDst.y = target.y + target.h - (pageDst.y - target.y) - pageDst.h;
+    }
+    SDL_FPoint center = { target.x + target.w / 2.0f - pageDst.x, target.y + target.h / 2.0f - pageDst.y };
+    SDL_RenderTextureRotated(renderer, entry->texture, &pageSrc, &pageDst, angle, &center, flip);
+}
+
+void TextureHandle::setAlphaMod(Uint8 alpha) const
+{
+    if (entry && entry->texture) {
+        SDL_SetTextureAlphaMod(entry->texture, alpha);
+
+        //Premultiplied pixels from the bundle need their color scaled along with the alpha
+        SDL_BlendMode blendMode;
+        if (SDL_GetTextureBlendMode(entry->texture, &blendMode) && blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+            SDL_SetTextureColorMod(entry->texture, alpha, alpha, alpha);
+        }
+    }
+}
+
+// -------- TextureCache --------
+
+TextureCache::TextureCache(SDL_Renderer* renderer, AssetLoader* loader)
+    : renderer(renderer), loader(loader)
+{
+    //1x1 fully transparent, stands in for textures that are still loading
+    placeholder = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (placeholder) {
+        Uint32 clear = 0;
+        SDL_UpdateTexture(placeholder, nullptr, &clear, sizeof(clear));
+        SDL_SetTextureBlendMode(placeholder, SDL_BLENDMODE_BLEND);
+    }
+
+    atlas.loadManifest(ATLAS_MANIFEST);
+    bundle.open(BUNDLE_PATH);
+    thumbnails.load(THUMBNAILS_PATH);
+    loadTiers();
+}
+
+//Manifest lines are "tier <dir> <scale> <logical scale>", smallest tier first
+void TextureCache::loadTiers()
+{
+    size_t dataSize = 0;
+    char* data = static_cast<char*>(SDL_LoadFile(TIERS_MANIFEST, &dataSize));
+    if (!data) return; //No tiers generated, always load the authored images
+
+    string contents(data, dataSize);
+    SDL_free(data);
+
+    size_t lineStart = 0;
+    while (lineStart < contents.size()) {
+        size_t lineEnd = contents.find('\n', lineStart);
+        if (lineEnd == string::npos) lineEnd = contents.size();
+        string line = contents.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        char dir[256];
+        Tier tier;
+        if (SDL_sscanf(line.c_str(), "tier %255s %f %f", dir, &tier.scale, &tier.logicalScale) == 3) {
+            tier.dir = dir;
+            tiers.push_back(tier);
+        }
+    }
+    sort(tiers.begin(), tiers.end(), [](const Tier& a, const Tier& b) { return a.logicalScale < b.logicalScale; });
+}
+
+void TextureCache::updateOutputSize()
+{
+    if (tiers.empty()) return;
+
+    int outputW = 0, outputH = 0, logicalW = 0, logicalH = 0;
+    SDL_GetCurrentRenderOutputSize(renderer, &outputW, &outputH);
+    SDL_GetRenderLogicalPresentation(renderer, &logicalW, &logicalH, nullptr);
+    if (outputW <= 0 || outputH <= 0 || logicalW <= 0 || logicalH <= 0) return;
+
+    //Smallest tier that isn't magnified on screen, the authored images beyond that
+    float needed = max(static_cast<float>(outputW) / logicalW, static_cast<float>(outputH) / logicalH);
+    int tier = -1;
+    for (size_t i = 0; i < tiers.size(); i++) {
+        if (tiers[i].logicalScale >= needed) {
+            tier = static_cast<int>(i);
+            break;
+        }
+    }
+    if (tier == currentTier) return;
+
+    currentTier = tier;
+    cout << "Output is " << outputW << "x" << outputH << ", loading "
+         << (tier >= 0 ? tiers[tier].dir : string("full resolution")) << " textures" << endl;
+    reloadForTier();
+}
+
+//Where to load path from for the current tier, falling back to path itself
+string TextureCache::resolveFile(const string& path, float& scale) const
+{
+    scale = 1.0f;
+    size_t resLength = SDL_strlen(RES_DIR);
+    if (currentTier < 0 || path.compare(0, resLength, RES_DIR) != 0) return path;
+
+    const Tier& tier = tiers[currentTier];
+    string file = string(RES_DIR) + "tiers/" + tier.dir + "/" + path.substr(resLength);
+    if (!bundle.contains(file) && !SDL_GetPathInfo(file.c_str(), nullptr)) return path;
+
+    scale = tier.scale;
+    return file;
+}
+
+//Drops textures nobody uses and reloads the rest in the background, drawing the old ones meanwhile
+void TextureCache::reloadForTier()
+{
+    //Unused textures are simply dropped, they load at the new tier if acquired again
+    for (auto it = unused.begin(); it != unused.end();) {
+        TextureEntry* entry = *it;
+        if (entry->loadId || entry->reloadId) { //Picks up the new tier on its next load
+            ++it;
+            continue;
+        }
+        it = unused.erase(it);
+        destroyEntry(entry);
+    }
+
+    //Held entries can't be destroyed by the budget, so this list stays valid while reloading
+    vector<TextureEntry*> held;
+    for (auto& pair : entries) {
+        TextureEntry* entry = pair.second.get();
+        if (entry->refs > 0 && !entry->loadId && !entry->reloadId) {
+            held.push_back(entry);
+        }
+    }
+
+    for (TextureEntry* entry : held) {
+        float scale;
+        string file = resolveFile(entry->path, scale);
+        if (file == entry->file) continue;
+
+        if (entry->evicted) { //Nothing loaded to replace, the next reload uses the new tier
+            entry->file = file;
+            entry->scale = scale;
+            continue;
+        }
+
+        if (!loader || bundle.contains(file)) {
+            SDL_Texture* texture = loadNow(file);
+            if (!texture) continue;
+            entry->file = file;
+            entry->scale = scale;
+            setTexture(entry, texture);
+            continue;
+        }
+
+        entry->reloadId = loader->loadTexture(file, [this, entry, file, scale](SDL_Texture* texture) {
+            entry->reloadId = 0;
+            if (!texture) return; //Keep the old tier
+            entry->file = file;
+            entry->scale = scale;
+            setTexture(entry, texture);
+            trimUnused();
+        });
+    }
+}
+
+//Blocking load, from the bundle when the file was cooked
+SDL_Texture* TextureCache::loadNow(const string& file)
+{
+    SDL_Texture* texture = bundle.createTexture(renderer, file);
+    if (!texture) {
+        SDL_Surface* surface = loadImage(file);
+        if (surface) {
+            texture = SDL_CreateTextureFromSurface(renderer, surface);
+            SDL_DestroySurface(surface);
+        }
+    }
+    if (!texture) {
+        cout << "Error loading texture " << file << ": " << SDL_GetError() << endl;
+    }
+    return texture;
+}
+
+//Swaps in a newly loaded texture and accounts for its memory
+void TextureCache::setTexture(TextureEntry* entry, SDL_Texture* texture)
+{
+    dropTexture(entry);
+    entry->texture = texture;
+    entry->evicted = false;
+    if (!texture) return;
+
+    entry->width = texture->w / entry->scale;
+    entry->height = texture->h / entry->scale;
+    entry->bytes = static_cast<size_t>(texture->w) * texture->h * SDL_BYTESPERPIXEL(texture->format);
+    entry->lastDrawnFrame = frame; //Counts as fresh, or it would be the first thing evicted
+    usedBytes += entry->bytes;
+    enforceBudget(entry); //Evicting what just arrived would only load it again when it is drawn
+}
+
+void TextureCache::dropTexture(TextureEntry* entry)
+{
+    if (!entry->texture) return;
+
+    SDL_DestroyTexture(entry->texture);
+    entry->texture = nullptr;
+    usedBytes -= entry->bytes;
+    entry->bytes = 0;
+}
+
+void TextureCache::setBudget(size_t bytes)
+{
+    budget = bytes;
+    overBudgetWarned = false;
+    enforceBudget();
+}
+
+//keep is never evicted, even when nobody holds it
+void TextureCache::enforceBudget(TextureEntry* keep)
+{
+    if (budget == 0 || usedBytes <= budget) return;
+
+    //Textures nobody holds go first, oldest release first
+    auto it = unused.end();
+    while (usedBytes > budget && it != unused.begin()) {
+        --it;
+        if ((*it)->loadId || (*it)->reloadId || *it == keep) continue;
+        TextureEntry* oldest = *it;
+        it = unused.erase(it);
+        destroyEntry(oldest);
+    }
+
+    //Then the least recently drawn of those still held. Ones drawn this frame stay,
+    //evicting them would only reload them on the next frame.
+    while (usedBytes > budget) {
+        TextureEntry* victim = nullptr;
+        for (auto& pair : entries) {
+            TextureEntry* entry = pair.second.get();
+            if (!entry->texture || entry->loadId || entry->reloadId || entry->lastDrawnFrame >= frame || entry == keep) continue;
+            if (!victim || entry->lastDrawnFrame < victim->lastDrawnFrame) {
+                victim = entry;
+            }
+        }
+        if (!victim) break;
+
+        dropTexture(victim);
+        victim->evicted = true;
+        evictions++;
+    }
+
+    if (usedBytes > budget && !overBudgetWarned) {
+        cout << "Texture memory " << usedBytes / (1024 * 1024) << " MB is over the "
+             << budget / (1024 * 1024) << " MB budget with everything evictable freed" << endl;
+        overBudgetWarned = true;
+    }
+}
+
+//Brings back a texture evicted for the budget. Drawing holds the world lock, so this never
+//blocks: the texture loads in the background, or in beginFrame() when it can't.
+void TextureCache::queueReload(TextureEntry* entry)
+{
+    if (loader && !bundle.contains(entry->file)) {
+        float scale = entry->scale;
+        entry->loadId = loader->loadTexture(entry->file, [this, entry, scale](SDL_Texture* texture) {
+            entry->loadId = 0;
+            entry->scale = scale; //Back from the thumbnail's scale
+            setTexture(entry, texture);
+        });
+        if (entry->loadId) {
+            entry->evicted = false;
+            showThumbnail(entry);
+            return;
+        }
+    }
+    if (find(queuedReloads.begin(), queuedReloads.end(), entry) == queuedReloads.end()) {
+        queuedReloads.push_back(entry); //Still evicted, so it draws nothing until then
+    }
+}
+
+void TextureCache::beginFrame()
+{
+    frame++;
+
+    //One at a time, the budget may destroy queued entries while these load
+    while (!queuedReloads.empty()) {
+        TextureEntry* entry = queuedReloads.back();
+        queuedReloads.pop_back();
+        if (!entry->evicted) continue; //acquire() got to it first
+        entry->evicted = false;
+        setTexture(entry, loadNow(entry->file));
+    }
+}
+
+//Puts the thumbnail up while the full image loads, the load callback restores the scale
+void TextureCache::showThumbnail(TextureEntry* entry)
+{
+    float scale;
+    SDL_Texture* texture = thumbnails.createTexture(renderer, entry->path, scale);
+    if (!texture) return;
+
+    entry->scale = scale;
+    setTexture(entry, texture);
+}
+
+//Scene a texture belongs to, from its folder under sprites or its atlas page name
+string TextureCache::sceneOf(const string& path)
+{
+    size_t sprites = path.find("sprites/");
+    if (sprites != string::npos) {
+        size_t start = sprites + SDL_strlen("sprites/");
+        size_t slash = path.find('/', start);
+        return slash != string::npos ? path.substr(start, slash - start) : "shared";
+    }
+    size_t atlasDir = path.find("atlas/");
+    if (atlasDir != string::npos) {
+        string page = path.substr(atlasDir + SDL_strlen("atlas/"));
+        return page.substr(0, page.rfind('_'));
+    }
+    return "other";
+}
+
+void TextureCache::logUsage() const
+{
+    struct SceneUsage {
+        int textures = 0;
+        int inUse = 0;
+        int evicted = 0;
+        size_t bytes = 0;
+    };
+    map<string, SceneUsage> scenes;
+    for (const auto& pair : entries) {
+        const TextureEntry* entry = pair.second.get();
+        SceneUsage& usage = scenes[sceneOf(entry->path)];
+        usage.textures++;
+        usage.bytes += entry->bytes;
+        if (entry->refs > 0) usage.inUse++;
+        if (entry->evicted) usage.evicted++;
+    }
+
+    cout << "Texture memory: " << usedBytes / (1024 * 1024) << " MB";
+    if (budget > 0) {
+        cout << " of " << budget / (1024 * 1024) << " MB budget";
+    }
+    cout << ", " << evictions << " evictions" << endl;
+    cout << left << setw(16) << "  scene" << right << setw(10) << "textures" << setw(8) << "in use"
+         << setw(9) << "evicted" << setw(10) << "MB" << endl;
+    for (const auto& scene : scenes) {
+        cout << left << setw(16) << ("  " + scene.first) << right
+             << setw(10) << scene.second.textures
+             << setw(8) << scene.second.inUse
+             << setw(9) << scene.second.evicted
+             << setw(10) << fixed << setprecision(1) << scene.second.bytes / (1024.0 * 1024.0) << endl;
+    }
+    cout.unsetf(ios::fixed);
+}
+
+TextureCache::~TextureCache()
+{
+    for (auto& pair : entries) {
+        dropTexture(pair.second.get());
+    }
+    entries.clear();
+    unused.clear();
+
+    if (placeholder) {
+        SDL_DestroyTexture(placeholder);
+    }
+}
+
+TextureHandle TextureCache::acquire(const string& path)
+{
+    const AtlasSprite* sprite = atlas.find(path);
+    TextureHandle handle = acquireFile(sprite ? sprite->page : path);
+    handle.sprite = sprite;
+    return handle;
+}
+
+TextureHandle TextureCache::acquireAsync(const string& path)
+{
+    const AtlasSprite* sprite = atlas.find(path);
+    TextureHandle handle = acquireFileAsync(sprite ? sprite->page : path);
+    handle.sprite = sprite;
+    return handle;
+}
+
+TextureHandle TextureCache::acquireFile(const string& path)
+{
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        hits++;
+        //Take the reference first so finishing the load can't trim this entry away
+        TextureHandle handle(this, it->second.get());
+        if (handle.entry->loadId && loader) {
+            loader->finish(handle.entry->loadId); //Clears loadId through the load callback
+        }
+        else if (handle.entry->evicted) {
+            handle.entry->evicted = false;
+            setTexture(handle.entry, loadNow(handle.entry->file));
+        }
+        return handle;
+    }
+
+    misses++;
+    auto entry = make_unique<TextureEntry>();
+    entry->path = path;
+    entry->file = resolveFile(path, entry->scale);
+    TextureEntry* result = entry.get();
+    entries[path] = move(entry);
+
+    //Referenced before the texture is set so the budget can't free the new entry itself
+    TextureHandle handle(this, result);
+    setTexture(result, loadNow(result->file));
+    return handle;
+}
+
+TextureHandle TextureCache::acquireFileAsync(const string& path)
+{
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        hits++;
+        return TextureHandle(this, it->second.get());
+    }
+
+    float scale;
+    string file = resolveFile(path, scale);
+
+    //Cooked images are already decoded, only the upload is left to do
+    if (!loader || bundle.contains(file)) {
+        return acquireFile(path);
+    }
+
+    misses++;
+    auto entry = make_unique<TextureEntry>();
+    entry->path = path;
+    entry->file = file;
+    entry->scale = scale;
+    TextureEntry* result = entry.get();
+
+    //Entries are never destroyed while loading, so the callback can hold on to it
+    entries[path] = move(entry);
+    TextureHandle handle(this, result);
+    result->loadId = loader->loadTexture(file, [this, result, scale](SDL_Texture* texture) {
+        result->loadId = 0;
+        result->scale = scale; //Back from the thumbnail's scale
+        setTexture(result, texture);
+        trimUnused();
+    });
+    if (result->loadId == 0) { //Could not start reading, fall back to a blocking load
+        setTexture(result, loadNow(file));
+    }
+    else {
+        showThumbnail(result);
+    }
+    return handle;
+}
+
+void TextureCache::addRef(TextureEntry* entry)
+{
+    if (entry->refs == 0) {
+        unused.remove(entry); //Back in use, no longer a candidate for eviction
+    }
+    entry->refs++;
+}
+
+void TextureCache::release(TextureEntry* entry)
+{
+    entry->refs--;
+    if (entry->refs > 0) return;
+
+    unused.push_front(entry);
+    trimUnused();
+}
+
+//Frees the least recently released textures beyond the keep-alive count, skipping ones still loading
+void TextureCache::trimUnused()
+{
+    auto it = unused.end();
+    while (unused.size() > KEEP_ALIVE_COUNT && it != unused.begin()) {
+        --it;
+        if ((*it)->loadId || (*it)->reloadId) continue;
+        TextureEntry* oldest = *it;
+        it = unused.erase(it);
+        destroyEntry(oldest);
+    }
+}
+
+void TextureCache::destroyEntry(TextureEntry* entry)
+{
+    dropTexture(entry);
+    queuedReloads.erase(remove(queuedReloads.begin(), queuedReloads.end(), entry), queuedReloads.end());
+    string path = entry->path;
+    entries.erase(path); //Frees the entry itself
+}
+
+void TextureCache::logStats() const
+{
+    cout << "Texture cache: " << hits << " hits, " << misses << " misses, "
+         << entries.size() << " loaded (" << unused.size() << " unused)";
+    if (loader) {
+        cout << ", " << loader->getPendingCount() << " still loading";
+    }
+    cout << endl;
+}
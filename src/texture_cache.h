@@ -0,0 +1,185 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <array>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sprite_atlas.h"
+#include "asset_bundle.h"
+#include "thumbnails.h"
+
+using namespace std;
+
+class TextureCache;
+class AssetLoader;
+
+// One texture loaded from disk, shared by every handle to the same path
+struct TextureEntry {
+    string path;
+    string file;        // what was actually loaded, a resolution tier of path if one fits
+    float scale = 1.0f; // texture pixels per pixel of the image at path
+    float width = 0.0f; // authored size of the image at path
+    float height = 0.0f;
+    SDL_Texture* texture = nullptr;
+    size_t bytes = 0;   // GPU memory held by texture
+    uint64_t lastDrawnFrame = 0;
+    bool evicted = false; // texture dropped to stay in budget, reloaded when next drawn
+    int refs = 0;
+    uint64_t loadId = 0;   // AssetLoader id while the texture is still loading, 0 once ready
+    uint64_t reloadId = 0; // AssetLoader id while switching tiers, the old texture stays usable
+};
+
+// Shared reference to a cached texture. Copies add a reference and the texture
+// goes back to the cache when the last handle lets go of it.
+// While an async load is in flight get() returns the image's thumbnail, or a
+// transparent placeholder when no thumbnails were generated.
+// A handle to a sprite that was packed into an atlas refers to the whole page, so
+// draw it with render()/renderRotated() rather than passing get() to SDL directly.
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(const TextureHandle& other);
+    TextureHandle& operator=(TextureHandle&& other) noexcept;
+    ~TextureHandle();
+
+    SDL_Texture* get() const;
+    bool isReady() const { return entry && entry->loadId == 0; }
+    explicit operator bool() const { return get() != nullptr; }
+    void reset();
+
+    // Size of the image as authored, whatever resolution tier was loaded.
+    // Known once the thumbnail is up, and for atlas sprites even before the page is loaded.
+    float getWidth() const;
+    float getHeight() const;
+
+    // Same as SDL_RenderTexture/SDL_RenderTextureRotated with src in image coordinates.
+    // Draws the thumbnail until the texture has loaded, nothing without one.
+    void render(SDL_Renderer* renderer, const SDL_FRect* src, const SDL_FRect* dst) const;
+    void renderRotated(SDL_Renderer* renderer, const SDL_FRect* src, const SDL_FRect* dst,
+        double angle, SDL_FlipMode flip) const;
+    // Atlas pages are shared, so reset the alpha once the sprite is drawn
+    void setAlphaMod(Uint8 alpha) const;
+
+private:
+    friend class TextureCache;
+    TextureHandle(TextureCache* cache, TextureEntry* entry);
+    bool mapToPage(SDL_Renderer* renderer, const SDL_FRect* src, const SDL_FRect* dst,
+        SDL_FRect& pageSrc, SDL_FRect& pageDst) const;
+    SDL_Texture* prepareDraw() const;
+
+    TextureCache* cache = nullptr;
+    TextureEntry* entry = nullptr;
+    const AtlasSprite* sprite = nullptr; // set when the image lives on an atlas page
+};
+
+// Central texture cache keyed by file path.
+// Paths of sprites listed in the atlas manifest resolve to their atlas page, so
+// every sprite of a scene shares one texture. Files found in the cooked asset
+// bundle are uploaded from it directly instead of decoding the PNG.
+// When downscaled tiers have been generated, the smallest one that still covers the
+// window's pixel size is loaded; handles keep working in authored image coordinates.
+// With a memory budget set, going over it frees unused textures first and then the
+// least recently drawn ones, which reload the next time they are drawn.
+// Scenes acquire shared handles instead of calling IMG_LoadTexture themselves, so a
+// texture used by several scenes is decoded once. Textures nobody references are
+// kept alive for a while (most recently released first) so switching between
+// minigames does not decode the same PNGs again.
+class TextureCache {
+public:
+    TextureCache(SDL_Renderer* renderer, AssetLoader* loader = nullptr);
+    ~TextureCache();
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // Returns a ready texture, waiting for an async load of the same path if one is running.
+    // Use this when the texture size is needed straight away.
+    TextureHandle acquire(const string& path);
+    // Returns immediately and loads in the background, drawing the thumbnail until then
+    TextureHandle acquireAsync(const string& path);
+
+    // Picks the resolution tier for the current output size, reloading textures if it changed.
+    // Call when the window's pixel size changes.
+    void updateOutputSize();
+
+    // Caps the GPU memory used by textures, 0 for no cap
+    void setBudget(size_t bytes);
+    size_t getUsedBytes() const { return usedBytes; }
+    // Marks the start of a frame for least-recently-drawn tracking, and does the blocking
+    // reloads drawing queued. Call outside the world lock.
+    void beginFrame();
+    // Prints texture memory per scene
+    void logUsage() const;
+
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+    void logStats() const;
+
+private:
+    friend class TextureHandle;
+    void addRef(TextureEntry* entry);
+    void release(TextureEntry* entry);
+    void destroyEntry(TextureEntry* entry);
+    void trimUnused();
+    TextureHandle acquireFile(const string& file);
+    TextureHandle acquireFileAsync(const string& file);
+    SDL_Texture* loadNow(const string& file);
+    string resolveFile(const string& path, float& scale) const;
+    void loadTiers();
+    void reloadForTier();
+    void setTexture(TextureEntry* entry, SDL_Texture* texture);
+    void dropTexture(TextureEntry* entry);
+    void enforceBudget(TextureEntry* keep = nullptr);
+    void queueReload(TextureEntry* entry);
+    void showThumbnail(TextureEntry* entry);
+    static string sceneOf(const string& path);
+
+    // Downscaled copies of src/res written by tools/asset_tiers.cpp
+    struct Tier {
+        string dir;
+        float scale;        // relative to the authored images
+        float logicalScale; // output pixels per logical pixel the tier is meant for
+    };
+    vector<Tier> tiers;     // smallest first
+    int currentTier = -1;   // -1 loads the authored images
+
+    SDL_Renderer* renderer;
+    AssetLoader* loader;
+    SDL_Texture* placeholder = nullptr;
+    SpriteAtlas atlas;
+    AssetBundle bundle;
+    ThumbnailSet thumbnails;
+    unordered_map<string, unique_ptr<TextureEntry>> entries;
+    list<TextureEntry*> unused; // unreferenced but still loaded, most recently released first
+    vector<TextureEntry*> queuedReloads; // evicted textures drawing asked for that can't load in the background
+    const size_t KEEP_ALIVE_COUNT = 24;
+
+    size_t usedBytes = 0;
+    size_t budget = 0;
+    uint64_t frame = 1;
+    bool overBudgetWarned = false;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+// Textures of one sprite folder in a flat array, indexed by the ids in asset_ids.h,
+// eg. SpriteSet<Sprites::CuttingGame> looked up with Sprites::CuttingGame::BG
+template <typename Folder>
+class SpriteSet {
+public:
+    void acquire(TextureCache* cache, typename Folder::Id id) { textures[id] = cache->acquire(Folder::PATHS[id]); }
+    void acquireAsync(TextureCache* cache, typename Folder::Id id) { textures[id] = cache->acquireAsync(Folder::PATHS[id]); }
+    const TextureHandle& operator[](typename Folder::Id id) const { return textures[id]; }
+    // Releases every texture back to the cache
+    void reset() { textures.fill(TextureHandle()); }
+
+private:
+    array<TextureHandle, Folder::COUNT> textures;
+};
@@ -0,0 +1,104 @@
+#include "thumbnails.h"
+#include "sprite_atlas.h"
+#include <iostream>
+
+using namespace std;
+
+namespace {
+    const char THUMBNAIL_MAGIC[8] = { 'C', 'M', 'T', 'H', 'U', 'M', 'B', '1' };
+
+    //Little endian readers that stop at the end of the data
+    struct Reader {
+        const Uint8* data;
+        size_t size;
+        size_t pos = 0;
+
+        bool read(void* out, size_t count)
+        {
+            if (count > size - pos) return false;
+            SDL_memcpy(out, data + pos, count);
+            pos += count;
+            return true;
+        }
+        bool read16(Uint16& out)
+        {
+            if (!read(&out, sizeof(out))) return false;
+            out = SDL_Swap16LE(out);
+            return true;
+        }
+        bool read32(Uint32& out)
+        {
+            if (!read(&out, sizeof(out))) return false;
+            out = SDL_Swap32LE(out);
+            return true;
+        }
+    };
+}
+
+bool ThumbnailSet::load(const string& path)
+{
+    size_t dataSize = 0;
+    Uint8* data = static_cast<Uint8*>(SDL_LoadFile(path.c_str(), &dataSize));
+    if (!data) {
+        return false; //No thumbnails generated, streamed textures show nothing until loaded
+    }
+
+    Reader reader{ data, dataSize };
+    char magic[8];
+    Uint32 count = 0;
+    bool valid = reader.read(magic, sizeof(magic)) && SDL_memcmp(magic, THUMBNAIL_MAGIC, sizeof(magic)) == 0
+        && reader.read32(count);
+
+    for (Uint32 i = 0; i < count && valid; i++) {
+        Uint16 pathLength, originalWidth, originalHeight, width, height;
+        string imagePath;
+        valid = reader.read16(pathLength);
+        if (valid) {
+            imagePath.resize(pathLength);
+            valid = reader.read(imagePath.data(), pathLength);
+        }
+        valid = valid && reader.read16(originalWidth) && reader.read16(originalHeight)
+            && reader.read16(width) && reader.read16(height) && width > 0 && height > 0;
+
+        size_t pixelBytes = static_cast<size_t>(width) * height * 4;
+        if (valid && pixelBytes <= dataSize - reader.pos) {
+            Thumbnail thumbnail;
+            thumbnail.originalWidth = originalWidth;
+            thumbnail.width = width;
+            thumbnail.height = height;
+            thumbnail.pixelOffset = pixels.size();
+            pixels.insert(pixels.end(), data + reader.pos, data + reader.pos + pixelBytes);
+            reader.pos += pixelBytes;
+            thumbnails[SpriteAtlas::normalizePath(imagePath)] = thumbnail;
+        }
+        else {
+            valid = false;
+        }
+    }
+    SDL_free(data);
+
+    if (!valid) {
+        cout << "Thumbnail file " << path << " is corrupt, ignoring it" << endl;
+        thumbnails.clear();
+        pixels.clear();
+        return false;
+    }
+    return true;
+}
+
+SDL_Texture* ThumbnailSet::createTexture(SDL_Renderer* renderer, const string& path, float& scale) const
+{
+    auto it = thumbnails.find(SpriteAtlas::normalizePath(path));
+    if (it == thumbnails.end()) return nullptr;
+
+    const Thumbnail& thumbnail = it->second;
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+        thumbnail.width, thumbnail.height);
+    if (!texture) return nullptr;
+
+    SDL_UpdateTexture(texture, nullptr, pixels.data() + thumbnail.pixelOffset, thumbnail.width * 4);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_LINEAR); //Blurry rather than blocky while it stands in
+    scale = static_cast<float>(thumbnail.width) / thumbnail.originalWidth;
+    return texture;
+}
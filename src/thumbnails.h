@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Tiny previews of every image, generated by tools/thumbnails.cpp into one small file.
+// They are read once at startup so a scene can show blurry versions of its art on the
+// very first frame while the full textures are still decoding.
+//
+// File layout: "CMTHUMB1", Uint32 count, then per image: Uint16 path length, the path,
+// Uint16 width and height of the original, Uint16 width and height of the thumbnail,
+// and the thumbnail's RGBA32 pixels.
+class ThumbnailSet {
+public:
+    bool load(const string& path);
+
+    // Creates a texture from the thumbnail of path. scale is the thumbnail's size
+    // relative to the original. Returns nullptr when there is no thumbnail.
+    SDL_Texture* createTexture(SDL_Renderer* renderer, const string& path, float& scale) const;
+
+private:
+    struct Thumbnail {
+        int originalWidth = 0;
+        int width = 0;
+        int height = 0;
+        size_t pixelOffset = 0; // into pixels
+    };
+    unordered_map<string, Thumbnail> thumbnails; // keyed by normalized path
+    vector<Uint8> pixels;
+};
@@ -0,0 +1,171 @@
+// Cooks every PNG under src/res into src/res/assets.bundle.
+// Images are decoded once here, converted to the format the renderers upload natively,
+// premultiplied, and stored uncompressed with each pixel block aligned to a page, so the
+// game can memory map the bundle and upload straight from it. Identical images
+// (eg. the bowl sprite in both mixing_game/ and egg_game/) are stored once.
+// Run from the repository root: tools/cook_assets.sh
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../src/asset_bundle.h"
+
+using namespace std;
+
+namespace {
+    const char* RES_DIR = "src/res/";
+    const char* BUNDLE_PATH = "src/res/assets.bundle";
+    // BGRA in memory, what the Direct3D, Metal and Vulkan renderers use for their textures
+    const SDL_PixelFormat BUNDLE_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+    struct CookedImage {
+        string path;
+        SDL_Surface* surface = nullptr;
+        Uint64 hash = 0;
+        size_t block = 0; // index into the unique pixel blocks
+    };
+
+    //FNV-1a over the image size and pixels
+    Uint64 hashPixels(const SDL_Surface* surface)
+    {
+        Uint64 hash = 14695981039346656037ull;
+        auto mix = [&hash](const Uint8* bytes, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        mix(reinterpret_cast<const Uint8*>(&surface->w), sizeof(surface->w));
+        mix(reinterpret_cast<const Uint8*>(&surface->h), sizeof(surface->h));
+        mix(static_cast<const Uint8*>(surface->pixels), static_cast<size_t>(surface->pitch) * surface->h);
+        return hash;
+    }
+
+    bool samePixels(const SDL_Surface* a, const SDL_Surface* b)
+    {
+        return a->w == b->w && a->h == b->h && a->pitch == b->pitch
+            && SDL_memcmp(a->pixels, b->pixels, static_cast<size_t>(a->pitch) * a->h) == 0;
+    }
+
+    Uint64 alignUp(Uint64 value)
+    {
+        return (value + BUNDLE_ALIGNMENT - 1) / BUNDLE_ALIGNMENT * BUNDLE_ALIGNMENT;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (!SDL_Init(0)) {
+        cout << "Error initializing SDL: " << SDL_GetError() << endl;
+        return 1;
+    }
+
+    int count = 0;
+    char** files = SDL_GlobDirectory(RES_DIR, nullptr, 0, &count);
+    if (!files) {
+        cout << "Error listing " << RES_DIR << ": " << SDL_GetError() << endl;
+        return 1;
+    }
+
+    vector<CookedImage> images;
+    vector<size_t> blocks; // first image holding each unique block
+    unordered_map<Uint64, vector<size_t>> blocksByHash;
+    size_t sourceBytes = 0;
+    for (int i = 0; i < count; i++) {
+        string relative = files[i];
+        if (relative.size() < 4 || SDL_strcasecmp(relative.c_str() + relative.size() - 4, ".png") != 0) continue;
+
+        CookedImage image;
+        image.path = RES_DIR + relative;
+        SDL_Surface* loaded = IMG_Load(image.path.c_str());
+        if (!loaded) {
+            cout << "Error loading " << image.path << ": " << SDL_GetError() << endl;
+            continue;
+        }
+        image.surface = SDL_ConvertSurface(loaded, BUNDLE_FORMAT);
+        SDL_DestroySurface(loaded);
+        if (!image.surface || !SDL_PremultiplySurfaceAlpha(image.surface, false)) {
+            cout << "Error converting " << image.path << ": " << SDL_GetError() << endl;
+            return 1;
+        }
+        image.hash = hashPixels(image.surface);
+        sourceBytes += static_cast<size_t>(image.surface->pitch) * image.surface->h;
+
+        //Hashes only pick the candidates, the pixels decide
+        size_t imageIndex = images.size();
+        image.block = SIZE_MAX;
+        for (size_t block : blocksByHash[image.hash]) {
+            if (samePixels(images[blocks[block]].surface, image.surface)) {
+                image.block = block;
+                cout << image.path << " is identical to " << images[blocks[block]].path << endl;
+                break;
+            }
+        }
+        if (image.block == SIZE_MAX) {
+            image.block = blocks.size();
+            blocks.push_back(imageIndex);
+            blocksByHash[image.hash].push_back(image.block);
+        }
+        images.push_back(image);
+    }
+    SDL_free(files);
+
+    //Lay out the file: header, entry table, path strings, then page aligned pixel blocks
+    Uint64 offset = sizeof(BundleHeader) + images.size() * sizeof(BundleEntry);
+    vector<BundleEntry> entries(images.size());
+    for (size_t i = 0; i < images.size(); i++) {
+        entries[i].pathOffset = static_cast<Uint32>(offset);
+        entries[i].pathLength = static_cast<Uint32>(images[i].path.size());
+        offset += images[i].path.size();
+    }
+    vector<Uint64> blockOffsets(blocks.size());
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const SDL_Surface* surface = images[blocks[b]].surface;
+        offset = alignUp(offset);
+        blockOffsets[b] = offset;
+        offset += static_cast<Uint64>(surface->pitch) * surface->h;
+    }
+    for (size_t i = 0; i < images.size(); i++) {
+        const SDL_Surface* surface = images[i].surface;
+        entries[i].width = surface->w;
+        entries[i].height = surface->h;
+        entries[i].pitch = surface->pitch;
+        entries[i].format = BUNDLE_FORMAT;
+        entries[i].dataOffset = blockOffsets[images[i].block];
+        entries[i].contentHash = images[i].hash;
+    }
+
+    ofstream out(BUNDLE_PATH, ios::binary | ios::trunc);
+    if (!out) {
+        cout << "Error opening " << BUNDLE_PATH << " for writing" << endl;
+        return 1;
+    }
+    BundleHeader header;
+    SDL_memcpy(header.magic, BUNDLE_MAGIC, sizeof(header.magic));
+    header.version = BUNDLE_VERSION;
+    header.entryCount = static_cast<Uint32>(entries.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BundleEntry));
+    for (const CookedImage& image : images) {
+        out.write(image.path.data(), image.path.size());
+    }
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const SDL_Surface* surface = images[blocks[b]].surface;
+        Uint64 padding = blockOffsets[b] - static_cast<Uint64>(out.tellp());
+        out.write(string(padding, '\0').data(), padding);
+        out.write(static_cast<const char*>(surface->pixels), static_cast<size_t>(surface->pitch) * surface->h);
+    }
+    out.close();
+
+    cout << "Cooked " << images.size() << " images (" << blocks.size() << " unique) into " << BUNDLE_PATH
+         << ", " << offset / (1024 * 1024) << " MB, " << sourceBytes / (1024 * 1024) << " MB before deduplication" << endl;
+
+    for (CookedImage& image : images) {
+        SDL_DestroySurface(image.surface);
+    }
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Writes src/asset_ids.h, an id for every PNG under src/res/sprites.
+// Each folder becomes a struct in namespace Sprites with an Id enum (file names in upper
+// case) and the paths in the same order, so scenes keep their textures in flat arrays
+// and look them up by constant. The header checks with __has_include that every file it
+// names still exists, so deleting or renaming a sprite without rerunning this breaks the
+// build instead of showing no_texture at runtime.
+// Run from the repository root after adding, renaming or removing sprites: tools/gen_asset_ids.sh
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+    const char* SPRITES_DIR = "src/res/sprites";
+    const char* HEADER_PATH = "src/asset_ids.h";
+    const char* SHARED_FOLDER = "Shared"; // files directly in src/res/sprites
+
+    //cutting_game -> CuttingGame
+    string typeName(const string& folder)
+    {
+        string name;
+        bool upper = true;
+        for (char c : folder) {
+            if (!isalnum(static_cast<unsigned char>(c))) {
+                upper = true;
+                continue;
+            }
+            name += upper ? static_cast<char>(toupper(static_cast<unsigned char>(c))) : c;
+            upper = false;
+        }
+        return name;
+    }
+
+    //egg_result_0.png -> EGG_RESULT_0
+    string constantName(const fs::path& file)
+    {
+        string name;
+        for (char c : file.stem().string()) {
+            name += isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(toupper(static_cast<unsigned char>(c))) : '_';
+        }
+        if (name.empty() || isdigit(static_cast<unsigned char>(name[0]))) {
+            name = "SPRITE_" + name;
+        }
+        return name;
+    }
+}
+
+int main()
+{
+    //Folder type name -> sorted paths relative to src/res/sprites
+    map<string, vector<string>> folders;
+    error_code error;
+    for (fs::recursive_directory_iterator it(SPRITES_DIR, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) continue;
+        string extension = it->path().extension().string();
+        transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return tolower(c); });
+        if (extension != ".png") continue;
+
+        fs::path relative = fs::relative(it->path(), SPRITES_DIR);
+        string folder = relative.has_parent_path() ? typeName(relative.parent_path().generic_string()) : SHARED_FOLDER;
+        folders[folder].push_back(relative.generic_string());
+    }
+    if (error) {
+        cout << "Error listing " << SPRITES_DIR << ": " << error.message() << endl;
+        return 1;
+    }
+
+    ofstream out(HEADER_PATH, ios::trunc);
+    if (!out) {
+        cout << "Error opening " << HEADER_PATH << " for writing" << endl;
+        return 1;
+    }
+    out << "// Generated by tools/asset_ids.cpp from src/res/sprites, do not edit.\n"
+        << "// Rerun tools/gen_asset_ids.sh after adding, renaming or removing sprites.\n"
+        << "#pragma once\n\n"
+        << "namespace Sprites {\n";
+
+    size_t total = 0;
+    bool firstFolder = true;
+    for (auto& folder : folders) {
+        vector<string>& files = folder.second;
+        sort(files.begin(), files.end());
+
+        set<string> names;
+        for (const string& file : files) {
+            if (!names.insert(constantName(file)).second) {
+                cout << "Two sprites in " << folder.first << " are both called " << constantName(file)
+                     << ", rename one of them" << endl;
+                return 1;
+            }
+        }
+
+        if (!firstFolder) out << "\n";
+        firstFolder = false;
+        out << "    struct " << folder.first << " {\n"
+            << "        enum Id {\n";
+        for (const string& file : files) {
+            out << "            " << constantName(file) << ",\n";
+        }
+        out << "            COUNT\n"
+            << "        };\n"
+            << "        static constexpr const char* PATHS[COUNT] = {\n";
+        for (const string& file : files) {
+            out << "            \"" << SPRITES_DIR << "/" << file << "\",\n";
+        }
+        out << "        };\n"
+            << "    };\n";
+        total += files.size();
+    }
+    out << "}\n\n"
+        << "//Paths are relative to this header\n";
+    for (auto& folder : folders) {
+        for (const string& file : folder.second) {
+            string path = "res/sprites/" + file;
+            out << "#if !__has_include(\"" << path << "\")\n"
+                << "#error \"src/" << path << " is missing, restore it or rerun tools/gen_asset_ids.sh\"\n"
+                << "#endif\n";
+        }
+    }
+    out.close();
+
+    cout << "Wrote " << total << " sprite ids in " << folders.size() << " folders to " << HEADER_PATH << endl;
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Writes downscaled copies of the game's images for smaller output sizes.
+// The sprites are authored for an 1800 pixel wide canvas, 2.25x the 800x450 logical
+// render size, so a window showing the game at 1x or 2x pixel density samples far
+// more texels than it shows. Each tier holds every PNG under src/res/sprites and
+// src/res/atlas at 1x, 2x or 4x the logical size, in src/res/tiers/<n>x/ with the
+// same relative paths, plus tiers.txt which the game reads to pick one.
+// Tiers that would be as large as the authored images are skipped.
+// Run from the repository root: tools/make_tiers.sh
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const char* RES_DIR = "src/res/";
+    const char* TIERS_DIR = "src/res/tiers/";
+    const float SOURCE_SCALE = 1800.0f / 800.0f; // authored pixels per logical pixel
+    const int LOGICAL_SCALES[] = { 1, 2, 4 };
+
+    //Linear scaling only looks at neighbouring pixels, so halve first to avoid aliasing
+    SDL_Surface* downscale(SDL_Surface* source, int width, int height)
+    {
+        SDL_Surface* current = source;
+        while (current->w / 2 >= width && current->h / 2 >= height) {
+            SDL_Surface* half = SDL_ScaleSurface(current, current->w / 2, current->h / 2, SDL_SCALEMODE_LINEAR);
+            if (current != source) SDL_DestroySurface(current);
+            if (!half) return nullptr;
+            current = half;
+        }
+        SDL_Surface* result = SDL_ScaleSurface(current, width, height, SDL_SCALEMODE_LINEAR);
+        if (current != source) SDL_DestroySurface(current);
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (!SDL_Init(0)) {
+        cout << "Error initializing SDL: " << SDL_GetError() << endl;
+        return 1;
+    }
+
+    //Every image outside the tiers folder itself
+    vector<string> images;
+    int count = 0;
+    char** files = SDL_GlobDirectory(RES_DIR, nullptr, 0, &count);
+    if (!files) {
+        cout << "Error listing " << RES_DIR << ": " << SDL_GetError() << endl;
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        string relative = files[i];
+        bool isImage = relative.size() > 4 && SDL_strcasecmp(relative.c_str() + relative.size() - 4, ".png") == 0;
+        bool inScope = relative.rfind("sprites/", 0) == 0 || relative.rfind("atlas/", 0) == 0;
+        if (isImage && inScope) {
+            images.push_back(relative);
+        }
+    }
+    SDL_free(files);
+
+    SDL_CreateDirectory(TIERS_DIR);
+    ofstream manifest(string(TIERS_DIR) + "tiers.txt");
+    manifest << "# Generated by tools/asset_tiers.cpp, do not edit\n";
+
+    for (int logicalScale : LOGICAL_SCALES) {
+        float scale = logicalScale / SOURCE_SCALE;
+        if (scale >= 1.0f) continue;
+
+        string dir = to_string(logicalScale) + "x";
+        for (const string& relative : images) {
+            string source = RES_DIR + relative;
+            string target = TIERS_DIR + dir + "/" + relative;
+
+            SDL_Surface* image = IMG_Load(source.c_str());
+            if (!image) {
+                cout << "Error loading " << source << ": " << SDL_GetError() << endl;
+                continue;
+            }
+            int width = max(1, static_cast<int>(lround(image->w * scale)));
+            int height = max(1, static_cast<int>(lround(image->h * scale)));
+            SDL_Surface* scaled = downscale(image, width, height);
+            SDL_DestroySurface(image);
+            if (!scaled) {
+                cout << "Error scaling " << source << ": " << SDL_GetError() << endl;
+                return 1;
+            }
+
+            SDL_CreateDirectory(target.substr(0, target.rfind('/')).c_str());
+            bool saved = IMG_SavePNG(scaled, target.c_str());
+            SDL_DestroySurface(scaled);
+            if (!saved) {
+                cout << "Error saving " << target << ": " << SDL_GetError() << endl;
+                return 1;
+            }
+        }
+
+        manifest << "tier " << dir << " " << scale << " " << logicalScale << "\n";
+        cout << "Wrote " << images.size() << " images for the " << dir << " tier (scale " << scale << ")" << endl;
+    }
+
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Packs the sprites of each scene into atlas pages.
+// Every folder under src/res/sprites is one scene (menu_graph, egg_game, ...). Its PNGs
+// have their transparent borders trimmed and are packed into as few pages as fit,
+// written to src/res/atlas together with the atlas.txt manifest the game reads.
+// Run from the repository root: tools/pack_atlas.sh
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const char* SPRITES_DIR = "src/res/sprites/";
+    const char* ATLAS_DIR = "src/res/atlas/";
+    const int PAGE_SIZE = 4096; // supported by every renderer backend SDL ships
+    const int PADDING = 2;      // keeps linear filtering from bleeding between sprites
+
+    struct Sprite {
+        string path;
+        SDL_Surface* surface = nullptr;
+        SDL_Rect trimmed{};  // kept part of the image
+        int page = 0;
+        int x = 0, y = 0;    // position of the kept part on its page
+    };
+
+    //Bounds of the pixels that aren't fully transparent
+    SDL_Rect findOpaqueBounds(SDL_Surface* surface)
+    {
+        int minX = surface->w, minY = surface->h, maxX = -1, maxY = -1;
+        for (int y = 0; y < surface->h; y++) {
+            const Uint8* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+            for (int x = 0; x < surface->w; x++) {
+                if (row[x * 4 + 3] != 0) {
+                    minX = min(minX, x);
+                    maxX = max(maxX, x);
+                    minY = min(minY, y);
+                    maxY = max(maxY, y);
+                }
+            }
+        }
+        if (maxX < 0) {
+            return { 0, 0, 1, 1 }; //Nothing visible, keep a single pixel
+        }
+        return { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+    }
+
+    //Shelf packing: tallest sprites first, filled left to right in rows
+    int packScene(vector<Sprite*>& sprites, vector<SDL_Point>& pageSizes)
+    {
+        sort(sprites.begin(), sprites.end(), [](const Sprite* a, const Sprite* b) {
+            return a->trimmed.h > b->trimmed.h;
+        });
+
+        int page = 0, shelfX = 0, shelfY = 0, shelfHeight = 0;
+        pageSizes.assign(1, { 0, 0 });
+        for (Sprite* sprite : sprites) {
+            int w = sprite->trimmed.w + PADDING;
+            int h = sprite->trimmed.h + PADDING;
+            if (w > PAGE_SIZE || h > PAGE_SIZE) {
+                cout << sprite->path << " is larger than an atlas page" << endl;
+                return -1;
+            }
+
+            if (shelfX + w > PAGE_SIZE) { //Next shelf
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            if (shelfY + h > PAGE_SIZE) { //Next page
+                page++;
+                pageSizes.push_back({ 0, 0 });
+                shelfX = shelfY = shelfHeight = 0;
+            }
+
+            sprite->page = page;
+            sprite->x = shelfX;
+            sprite->y = shelfY;
+            shelfX += w;
+            shelfHeight = max(shelfHeight, h);
+            pageSizes[page].x = max(pageSizes[page].x, shelfX);
+            pageSizes[page].y = max(pageSizes[page].y, shelfY + h);
+        }
+        return page + 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (!SDL_Init(0)) {
+        cout << "Error initializing SDL: " << SDL_GetError() << endl;
+        return 1;
+    }
+    SDL_CreateDirectory(ATLAS_DIR);
+
+    //Group sprites by scene folder. Loose files in the sprites root stay unpacked.
+    map<string, vector<Sprite*>> scenes;
+    vector<Sprite> sprites;
+    int count = 0;
+    char** files = SDL_GlobDirectory(SPRITES_DIR, "*/*.png", SDL_GLOB_CASEINSENSITIVE, &count);
+    if (!files) {
+        cout << "Error listing " << SPRITES_DIR << ": " << SDL_GetError() << endl;
+        return 1;
+    }
+    sprites.reserve(count);
+    for (int i = 0; i < count; i++) {
+        Sprite sprite;
+        sprite.path = string(SPRITES_DIR) + files[i];
+        SDL_Surface* loaded = IMG_Load(sprite.path.c_str());
+        if (!loaded) {
+            cout << "Error loading " << sprite.path << ": " << SDL_GetError() << endl;
+            continue;
+        }
+        sprite.surface = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!sprite.surface) continue;
+
+        sprite.trimmed = findOpaqueBounds(sprite.surface);
+        sprites.push_back(sprite);
+    }
+    for (Sprite& sprite : sprites) {
+        string relative = sprite.path.substr(SDL_strlen(SPRITES_DIR));
+        scenes[relative.substr(0, relative.find('/'))].push_back(&sprite);
+    }
+    SDL_free(files);
+
+    ofstream manifest(string(ATLAS_DIR) + "atlas.txt");
+    manifest << "# Generated by tools/atlas_packer.cpp, do not edit\n";
+
+    int totalPages = 0;
+    for (auto& scene : scenes) {
+        vector<SDL_Point> pageSizes;
+        int pageCount = packScene(scene.second, pageSizes);
+        if (pageCount < 0) return 1;
+
+        for (int page = 0; page < pageCount; page++) {
+            string pagePath = string(ATLAS_DIR) + scene.first + "_" + to_string(page) + ".png";
+            SDL_Surface* pageSurface = SDL_CreateSurface(pageSizes[page].x, pageSizes[page].y, SDL_PIXELFORMAT_RGBA32);
+            if (!pageSurface) {
+                cout << "Error creating page " << pagePath << ": " << SDL_GetError() << endl;
+                return 1;
+            }
+            SDL_ClearSurface(pageSurface, 0.0f, 0.0f, 0.0f, 0.0f);
+
+            manifest << "page " << pagePath << "\n";
+            for (Sprite* sprite : scene.second) {
+                if (sprite->page != page) continue;
+
+                SDL_Rect dst = { sprite->x, sprite->y, sprite->trimmed.w, sprite->trimmed.h };
+                SDL_SetSurfaceBlendMode(sprite->surface, SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(sprite->surface, &sprite->trimmed, pageSurface, &dst);
+
+                manifest << "sprite " << sprite->path << " "
+                         << sprite->x << " " << sprite->y << " " << sprite->trimmed.w << " " << sprite->trimmed.h << " "
+                         << sprite->trimmed.x << " " << sprite->trimmed.y << " "
+                         << sprite->surface->w << " " << sprite->surface->h << "\n";
+            }
+
+            if (!IMG_SavePNG(pageSurface, pagePath.c_str())) {
+                cout << "Error saving " << pagePath << ": " << SDL_GetError() << endl;
+                return 1;
+            }
+            cout << pagePath << ": " << pageSizes[page].x << "x" << pageSizes[page].y << endl;
+            SDL_DestroySurface(pageSurface);
+        }
+        totalPages += pageCount;
+    }
+
+    cout << "Packed " << sprites.size() << " sprites into " << totalPages << " pages" << endl;
+    for (Sprite& sprite : sprites) {
+        SDL_DestroySurface(sprite.surface);
+    }
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,12 @@
+#!/usr/bin/env bash
+# Builds and runs the PNG decoder benchmark, optimized like a release build
+# Usage: tools/bench_png.sh [runs per image]
+set -e
+cd "$(dirname "$0")/.."
+cxx=${CXX:-clang++}
+$cxx -std=c++17 -O2 -Iframeworks/include \
+  tools/png_benchmark.cpp src/png_decoder.cpp \
+  -L/usr/local/lib -L/opt/homebrew/lib \
+  -lSDL3 -lSDL3_image \
+  -o tools/png_benchmark
+./tools/png_benchmark "$@"
@@ -0,0 +1,12 @@
+#!/usr/bin/env bash
+# Builds and runs the asset cooker, writing src/res/assets.bundle
+# Run tools/pack_atlas.sh and tools/make_tiers.sh first so their output is cooked too
+set -e
+cd "$(dirname "$0")/.."
+cxx=${CXX:-clang++}
+$cxx -std=c++17 -Iframeworks/include \
+  tools/asset_cooker.cpp \
+  -L/usr/local/lib -L/opt/homebrew/lib \
+  -lSDL3 -lSDL3_image \
+  -o tools/asset_cooker
+./tools/asset_cooker
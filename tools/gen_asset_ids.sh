@@ -0,0 +1,8 @@
+#!/usr/bin/env bash
+# Builds and runs the sprite id generator, writing src/asset_ids.h
+# Run after adding, renaming or removing anything under src/res/sprites
+set -e
+cd "$(dirname "$0")/.."
+cxx=${CXX:-clang++}
+$cxx -std=c++17 tools/asset_ids.cpp -o tools/asset_ids
+./tools/asset_ids
@@ -0,0 +1,12 @@
+#!/usr/bin/env bash
+# Builds and runs the thumbnail generator, writing src/res/thumbnails.bin
+# Run after tools/pack_atlas.sh
+set -e
+cd "$(dirname "$0")/.."
+cxx=${CXX:-clang++}
+$cxx -std=c++17 -Iframeworks/include \
+  tools/thumbnails.cpp \
+  -L/usr/local/lib -L/opt/homebrew/lib \
+  -lSDL3 -lSDL3_image \
+  -o tools/thumbnails
+./tools/thumbnails
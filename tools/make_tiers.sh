@@ -0,0 +1,12 @@
+#!/usr/bin/env bash
+# Builds and runs the resolution tier generator, writing src/res/tiers/
+# Run after tools/pack_atlas.sh and before tools/cook_assets.sh
+set -e
+cd "$(dirname "$0")/.."
+cxx=${CXX:-clang++}
+$cxx -std=c++17 -Iframeworks/include \
+  tools/asset_tiers.cpp \
+  -L/usr/local/lib -L/opt/homebrew/lib \
+  -lSDL3 -lSDL3_image \
+  -o tools/asset_tiers
+./tools/asset_tiers
@@ -0,0 +1,11 @@
+#!/usr/bin/env bash
+# Builds and runs the sprite atlas packer, writing src/res/atlas/
+set -e
+cd "$(dirname "$0")/.."
+cxx=${CXX:-clang++}
+$cxx -std=c++17 -Iframeworks/include \
+  tools/atlas_packer.cpp \
+  -L/usr/local/lib -L/opt/homebrew/lib \
+  -lSDL3 -lSDL3_image \
+  -o tools/atlas_packer
+./tools/atlas_packer
@@ -0,0 +1,127 @@
+// Times SDL_image against the fast PNG decoder on every PNG under src/res/sprites and
+// src/res/atlas, and checks that both produce the same pixels.
+// Files are read into memory first so only decoding is measured. The fast decoder's time
+// includes writing the renderer's format (ARGB8888 here), SDL_image's does not, its
+// surfaces are converted when uploaded.
+// Run from the repository root: tools/bench_png.sh [runs per image]
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/png_decoder.h"
+
+using namespace std;
+
+namespace {
+    const char* RES_DIR = "src/res/";
+    const SDL_PixelFormat FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+    //Best of the runs, the least disturbed by everything else on the machine
+    template <typename Decode>
+    double bestTimeMS(int runs, Decode decode)
+    {
+        Uint64 best = UINT64_MAX;
+        for (int i = 0; i < runs; i++) {
+            Uint64 start = SDL_GetTicksNS();
+            SDL_Surface* surface = decode();
+            best = min(best, SDL_GetTicksNS() - start);
+            SDL_DestroySurface(surface);
+        }
+        return best / 1e6;
+    }
+
+    bool samePixels(SDL_Surface* expected, SDL_Surface* actual)
+    {
+        SDL_Surface* converted = SDL_ConvertSurface(expected, FORMAT);
+        if (!converted) return false;
+
+        bool same = converted->w == actual->w && converted->h == actual->h;
+        for (int y = 0; same && y < actual->h; y++) {
+            same = SDL_memcmp(static_cast<Uint8*>(converted->pixels) + y * converted->pitch,
+                static_cast<Uint8*>(actual->pixels) + y * actual->pitch, actual->w * 4) == 0;
+        }
+        SDL_DestroySurface(converted);
+        return same;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int runs = argc > 1 ? max(1, SDL_atoi(argv[1])) : 5;
+    if (!SDL_Init(0)) {
+        cout << "Error initializing SDL: " << SDL_GetError() << endl;
+        return 1;
+    }
+
+    int count = 0;
+    char** files = SDL_GlobDirectory(RES_DIR, nullptr, 0, &count);
+    if (!files) {
+        cout << "Error listing " << RES_DIR << ": " << SDL_GetError() << endl;
+        return 1;
+    }
+    vector<string> images;
+    for (int i = 0; i < count; i++) {
+        string relative = files[i];
+        bool isImage = relative.size() > 4 && SDL_strcasecmp(relative.c_str() + relative.size() - 4, ".png") == 0;
+        bool inScope = relative.rfind("sprites/", 0) == 0 || relative.rfind("atlas/", 0) == 0;
+        if (isImage && inScope) {
+            images.push_back(RES_DIR + relative);
+        }
+    }
+    SDL_free(files);
+    sort(images.begin(), images.end());
+
+    cout << "Best of " << runs << " runs per image" << endl;
+    cout << left << setw(52) << "image" << right << setw(8) << "KB" << setw(12) << "SDL_image" << setw(10) << "fast"
+         << setw(9) << "speedup" << endl;
+
+    double totalSDL = 0.0, totalFast = 0.0;
+    int mismatches = 0, unsupported = 0;
+    for (const string& path : images) {
+        size_t size = 0;
+        void* data = SDL_LoadFile(path.c_str(), &size);
+        if (!data) {
+            cout << "Error reading " << path << ": " << SDL_GetError() << endl;
+            continue;
+        }
+
+        SDL_Surface* reference = IMG_Load_IO(SDL_IOFromConstMem(data, size), true);
+        SDL_Surface* fast = decodePng(data, size, FORMAT);
+        if (!reference) {
+            cout << "Error decoding " << path << ": " << SDL_GetError() << endl;
+        }
+        else if (!fast) {
+            cout << left << setw(52) << path << right << "  not handled, falls back to SDL_image" << endl;
+            unsupported++;
+        }
+        else {
+            bool same = samePixels(reference, fast);
+            if (!same) mismatches++;
+
+            double sdlMS = bestTimeMS(runs, [&]() { return IMG_Load_IO(SDL_IOFromConstMem(data, size), true); });
+            double fastMS = bestTimeMS(runs, [&]() { return decodePng(data, size, FORMAT); });
+            totalSDL += sdlMS;
+            totalFast += fastMS;
+            cout << left << setw(52) << path << right << setw(8) << size / 1024
+                 << fixed << setprecision(2) << setw(10) << sdlMS << "ms" << setw(8) << fastMS << "ms"
+                 << setw(8) << sdlMS / fastMS << "x" << (same ? "" : "  PIXELS DIFFER") << endl;
+            cout.unsetf(ios::fixed);
+        }
+        SDL_DestroySurface(reference);
+        SDL_DestroySurface(fast);
+        SDL_free(data);
+    }
+
+    cout << fixed << setprecision(1) << "Total: SDL_image " << totalSDL << " ms, fast " << totalFast << " ms";
+    if (totalFast > 0.0) {
+        cout << " (" << setprecision(2) << totalSDL / totalFast << "x)";
+    }
+    cout << ", " << unsupported << " not handled, " << mismatches << " with different pixels" << endl;
+
+    SDL_Quit();
+    return mismatches == 0 ? 0 : 1;
+}
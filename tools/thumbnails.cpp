@@ -0,0 +1,128 @@
+// Writes src/res/thumbnails.bin, a tiny copy of every PNG under src/res/sprites and
+// src/res/atlas. The game reads the whole file at startup and draws a thumbnail,
+// stretched to the full size, while the real image is still decoding in the background.
+// At 32 pixels on the long side all of them together are only a few hundred KB.
+// Run from the repository root: tools/make_thumbnails.sh
+// Run after tools/pack_atlas.sh so the atlas pages get thumbnails too.
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+namespace {
+    const char* RES_DIR = "src/res/";
+    const char* THUMBNAILS_PATH = "src/res/thumbnails.bin";
+    const int THUMBNAIL_SIZE = 32; // longest side in pixels
+
+    void write16(ofstream& out, Uint16 value)
+    {
+        value = SDL_Swap16LE(value);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void write32(ofstream& out, Uint32 value)
+    {
+        value = SDL_Swap32LE(value);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    //Linear scaling only looks at neighbouring pixels, so halve first to avoid aliasing
+    SDL_Surface* downscale(SDL_Surface* source, int width, int height)
+    {
+        SDL_Surface* current = source;
+        while (current->w / 2 >= width && current->h / 2 >= height) {
+            SDL_Surface* half = SDL_ScaleSurface(current, current->w / 2, current->h / 2, SDL_SCALEMODE_LINEAR);
+            if (current != source) SDL_DestroySurface(current);
+            if (!half) return nullptr;
+            current = half;
+        }
+        SDL_Surface* result = SDL_ScaleSurface(current, width, height, SDL_SCALEMODE_LINEAR);
+        if (current != source) SDL_DestroySurface(current);
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (!SDL_Init(0)) {
+        cout << "Error initializing SDL: " << SDL_GetError() << endl;
+        return 1;
+    }
+
+    int count = 0;
+    char** files = SDL_GlobDirectory(RES_DIR, nullptr, 0, &count);
+    if (!files) {
+        cout << "Error listing " << RES_DIR << ": " << SDL_GetError() << endl;
+        return 1;
+    }
+
+    ofstream out(THUMBNAILS_PATH, ios::binary | ios::trunc);
+    if (!out) {
+        cout << "Error opening " << THUMBNAILS_PATH << " for writing" << endl;
+        return 1;
+    }
+    out.write("CMTHUMB1", 8);
+    write32(out, 0); //Count, filled in at the end
+
+    Uint32 written = 0;
+    for (int i = 0; i < count; i++) {
+        string relative = files[i];
+        bool isImage = relative.size() > 4 && SDL_strcasecmp(relative.c_str() + relative.size() - 4, ".png") == 0;
+        bool inScope = relative.rfind("sprites/", 0) == 0 || relative.rfind("atlas/", 0) == 0;
+        if (!isImage || !inScope) continue;
+
+        string path = RES_DIR + relative;
+        SDL_Surface* image = IMG_Load(path.c_str());
+        if (!image) {
+            cout << "Error loading " << path << ": " << SDL_GetError() << endl;
+            continue;
+        }
+        if (image->w > 0xFFFF || image->h > 0xFFFF) {
+            cout << "Skipping " << path << ", too large" << endl;
+            SDL_DestroySurface(image);
+            continue;
+        }
+
+        float scale = min(1.0f, static_cast<float>(THUMBNAIL_SIZE) / max(image->w, image->h));
+        int width = max(1, static_cast<int>(lround(image->w * scale)));
+        int height = max(1, static_cast<int>(lround(image->h * scale)));
+        SDL_Surface* scaled = downscale(image, width, height);
+        SDL_Surface* pixels = scaled ? SDL_ConvertSurface(scaled, SDL_PIXELFORMAT_RGBA32) : nullptr;
+        if (scaled) SDL_DestroySurface(scaled);
+        if (!pixels) {
+            cout << "Error scaling " << path << ": " << SDL_GetError() << endl;
+            SDL_DestroySurface(image);
+            return 1;
+        }
+
+        write16(out, static_cast<Uint16>(path.size()));
+        out.write(path.data(), path.size());
+        write16(out, static_cast<Uint16>(image->w));
+        write16(out, static_cast<Uint16>(image->h));
+        write16(out, static_cast<Uint16>(pixels->w));
+        write16(out, static_cast<Uint16>(pixels->h));
+        for (int y = 0; y < pixels->h; y++) { //Rows are written tightly packed
+            out.write(static_cast<const char*>(pixels->pixels) + y * pixels->pitch, pixels->w * 4);
+        }
+        written++;
+
+        SDL_DestroySurface(pixels);
+        SDL_DestroySurface(image);
+    }
+    SDL_free(files);
+
+    out.seekp(8);
+    write32(out, written);
+    out.seekp(0, ios::end);
+    cout << "Wrote " << written << " thumbnails to " << THUMBNAILS_PATH << " (" << out.tellp() / 1024 << " KB)" << endl;
+    out.close();
+
+    SDL_Quit();
+    return 0;
+}